@@ -0,0 +1,407 @@
+// Project: Maximum Independent Set (MIS, version 5)
+// Computer Science (2016-2017), 4th semester
+// Author: Guillaume Cocatre-Zilgien
+// Professor: Michel Ventou
+
+// Runs the algorithms on the instances of a manifest, and keeps a record of their performance: for each instance and
+// each algorithm, a few warm-up runs, then a number of measured runs, each in a process of its own (so that the peak
+// memory is the one of that run only). The graph is loaded and reduced as in the program itself, then only the
+// algorithm is timed. The results are printed, and saved as CSV and JSON; when a baseline (the CSV of an earlier run)
+// is given, the runs that got slower, that found a smaller set, or that took more memory are flagged as regressions.
+//
+// Each line of the manifest is "FILE ALGORITHMS [ DEADLINE ]": the path of a graph, a comma-separated list of
+// algorithms (mdg, vsa, mvsa, best, portfolio, exact, bitset), and the deadline of the exact algorithms in seconds.
+// Blank lines and lines that start with "#" are skipped; any other line must name at least one algorithm.
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <getopt.h>
+#include <map>
+#include <sstream>
+#include <string>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+#include "Graph.hpp"
+#include "Reducer.hpp"
+#include "SemiExternal.hpp"
+#include "Timer.hpp"
+
+using namespace std;
+
+#define DEFAULT_RUNS 5
+#define DEFAULT_WARMUP 1
+#define DEFAULT_DEADLINE 10.0                   // seconds, for the exact algorithms
+#define DEFAULT_THRESHOLD 10.0                  // percent over the baseline that counts as a regression
+#define MIN_REGRESSION_MS 1.0                   // smaller differences are noise, whatever the percentage
+#define MIN_REGRESSION_MB 1.0
+
+typedef struct {
+    bool ok;                                    // did the run load the graph and finish?
+    double setup;                               // milliseconds taken to load and reduce the graph
+    double milliseconds;                        // milliseconds taken by the algorithm
+    cardinal size;                              // cardinality of the set
+    unsigned long long calls;                   // recursive calls of the exact algorithms
+    double peakMemory;                          // peak resident set size of the run, in MB
+    misCheck check;
+    bool optimal;                               // false: the exact algorithm reached its deadline
+} runResult;
+
+typedef struct {
+    string instance;
+    string algorithm;
+    unsigned runs;                              // number of measured runs that finished
+    double setup, median, fastest, slowest;     // milliseconds (setup: median)
+    cardinal size;                              // smallest set of all the runs
+    unsigned long long calls;                   // median
+    double peakMemory;                          // largest of all the runs
+    string status;                              // maximal, not maximal, invalid, deadline, failed
+    string regression;                          // why it is slower or worse than the baseline (empty: it is not)
+} benchRow;
+
+typedef struct {
+    string path;
+    vector<algorithm> algorithms;
+    double deadline;
+} manifestEntry;
+
+const struct {
+    const char *name;
+    algorithm algo;
+} algorithmNames[] {
+    {"mdg", ALGO_MDG}, {"vsa", ALGO_VSA}, {"mvsa", ALGO_MVSA}, {"best", ALGO_BEST}, {"portfolio", ALGO_PORTFOLIO},
+    {"exact", ALGO_EXACT}, {"bitset", ALGO_EXACT_BITSET}
+};
+
+const char * getName(algorithm algo)
+{
+    for (auto &a : algorithmNames) {
+        if (a.algo == algo) return a.name;
+    }
+    return "?";
+}
+
+vector<manifestEntry> readManifest(const char *path)
+{
+    vector<manifestEntry> entries;
+    ifstream file(path);
+    if (!file.is_open()) {
+        fprintf(stderr, "Error: unable to open the manifest %s\n", path);
+        exit(1);
+    }
+    string line, name;
+    unsigned lineNumber {0};
+    while (getline(file, line)) {
+        ++lineNumber;
+        istringstream fields(line);
+        manifestEntry entry {"", {}, DEFAULT_DEADLINE};
+        string names;
+        if (!(fields >> entry.path) || entry.path[0] == '#') continue;
+        if (!(fields >> names)) {
+            fprintf(stderr, "Error: no algorithm at line %u of %s\n", lineNumber, path);
+            exit(1);
+        }
+        fields >> entry.deadline;
+        istringstream list(names);
+        while (getline(list, name, ',')) {
+            unsigned before = entry.algorithms.size();
+            for (auto &a : algorithmNames) {
+                if (name == a.name) entry.algorithms.push_back(a.algo);
+            }
+            if (entry.algorithms.size() == before) {
+                fprintf(stderr, "Error: unknown algorithm \"%s\" at line %u of %s\n", name.c_str(), lineNumber, path);
+                exit(1);
+            }
+        }
+        entries.push_back(entry);
+    }
+    return entries;
+}
+
+/**
+ *  The exact algorithms start from the result of the heuristics, as in the program (they only look for larger sets),
+ *  so BEST runs first, without being timed.
+ */
+runResult runOnce(const manifestEntry &entry, algorithm algo)
+{
+    runResult r {false, 0.0, 0.0, 0, 0, 0.0, MIS_INVALID, true};
+    Timer t;
+    Graph g(entry.path.c_str());
+    if (g.getSize() == 0) return r;
+    Graph original(g);
+    Reducer reducer(g, true);
+    reducer.enqueueAll();
+    reducer.reduce();
+    r.setup = t.countMilliseconds();
+    if (algo == ALGO_EXACT || algo == ALGO_EXACT_BITSET) {
+        g.findMIS(ALGO_BEST);
+        g.setDeadline(entry.deadline);
+    } else if (algo == ALGO_PORTFOLIO) {
+        g.setPortfolio(max(thread::hardware_concurrency(), 1u), DEFAULT_PORTFOLIO_TIME);
+    }
+    t.reset();
+    vidSet set {g.findMIS(algo)};
+    r.milliseconds = t.countMilliseconds();
+    r.size = set.size();
+    r.calls = g.getNumberOfCalls();
+    r.optimal = (algo != ALGO_EXACT && algo != ALGO_EXACT_BITSET) || g.isOptimal();
+    r.check = original.checkMIS(set);
+    r.peakMemory = SemiExternal::getPeakMemory();
+    r.ok = true;
+    return r;
+}
+
+// The run happens in a child process, that sends its result back through a pipe
+runResult runIsolated(const manifestEntry &entry, algorithm algo)
+{
+    runResult r {false, 0.0, 0.0, 0, 0, 0.0, MIS_INVALID, true};
+    int fds[2];
+    if (pipe(fds) != 0) return r;
+    fflush(stdout);
+    pid_t pid {fork()};
+    if (pid == 0) {
+        close(fds[0]);
+        runResult child {runOnce(entry, algo)};
+        bool sent {write(fds[1], &child, sizeof(child)) == (ssize_t) sizeof(child)};
+        _exit(sent ? 0 : 1);
+    }
+    close(fds[1]);
+    if (pid > 0) {
+        if (read(fds[0], &r, sizeof(r)) != (ssize_t) sizeof(r)) r.ok = false;
+        waitpid(pid, nullptr, 0);
+    }
+    close(fds[0]);
+    return r;
+}
+
+benchRow measure(const manifestEntry &entry, algorithm algo, unsigned runs, unsigned warmup)
+{
+    benchRow row {entry.path, getName(algo), 0, 0.0, 0.0, 0.0, 0.0, 0, 0, 0.0, "failed", ""};
+    for (unsigned i = 0; i < warmup; ++i) {
+        runIsolated(entry, algo);
+    }
+    vector<double> setups, times;
+    vector<unsigned long long> calls;
+    misCheck check {MIS_MAXIMAL};
+    bool optimal {true};
+    for (unsigned i = 0; i < runs; ++i) {
+        runResult r {runIsolated(entry, algo)};
+        if (!r.ok) continue;
+        setups.push_back(r.setup);
+        times.push_back(r.milliseconds);
+        calls.push_back(r.calls);
+        row.size = (times.size() == 1) ? r.size : min(row.size, r.size);
+        row.peakMemory = max(row.peakMemory, r.peakMemory);
+        check = min(check, r.check);
+        optimal = optimal && r.optimal;
+    }
+    row.runs = times.size();
+    if (times.empty()) return row;
+    sort(setups.begin(), setups.end());
+    sort(times.begin(), times.end());
+    sort(calls.begin(), calls.end());
+    row.setup = setups[setups.size() / 2];
+    row.median = times[times.size() / 2];
+    row.fastest = times.front();
+    row.slowest = times.back();
+    row.calls = calls[calls.size() / 2];
+    row.status = (check == MIS_INVALID) ? "invalid" : !optimal ? "deadline" :
+                 (check == MIS_NOT_MAXIMAL) ? "not maximal" : "maximal";
+    return row;
+}
+
+// The baseline is the CSV of an earlier run (see saveCSV()), by instance and algorithm
+map<string, benchRow> readBaseline(const char *path)
+{
+    map<string, benchRow> baseline;
+    ifstream file(path);
+    if (!file.is_open()) {
+        fprintf(stderr, "Error: unable to open the baseline %s\n", path);
+        exit(1);
+    }
+    string line;
+    getline(file, line);                        // header
+    while (getline(file, line)) {
+        vector<string> fields;
+        string field;
+        istringstream columns(line);
+        while (getline(columns, field, ',')) fields.push_back(field);
+        if (fields.size() < 11) continue;
+        benchRow row {fields[0], fields[1], (unsigned) stoul(fields[2]), stod(fields[3]), stod(fields[4]),
+                      stod(fields[5]), stod(fields[6]), (cardinal) stoul(fields[7]), stoull(fields[8]),
+                      stod(fields[9]), fields[10], ""};
+        baseline[row.instance + "," + row.algorithm] = row;
+    }
+    return baseline;
+}
+
+// A run that reached its deadline is only compared on the size of its set (its time is the deadline)
+void compare(benchRow &row, const benchRow &base, double threshold)
+{
+    char reason[128] {""};
+    double factor {1.0 + threshold / 100.0};
+    if (row.size < base.size) {
+        snprintf(reason, sizeof(reason), "smaller set (%lu instead of %lu)", row.size, base.size);
+    } else if (row.status != "deadline" && row.median > base.median * factor
+               && row.median - base.median > MIN_REGRESSION_MS) {
+        snprintf(reason, sizeof(reason), "slower (%.1f ms instead of %.1f ms: %+.0f%%)", row.median, base.median,
+            (row.median / base.median - 1.0) * 100.0);
+    } else if (row.peakMemory > base.peakMemory * factor && row.peakMemory - base.peakMemory > MIN_REGRESSION_MB) {
+        snprintf(reason, sizeof(reason), "more memory (%.1f MB instead of %.1f MB)", row.peakMemory, base.peakMemory);
+    }
+    row.regression = reason;
+}
+
+void printRow(const benchRow &row, const benchRow *base)
+{
+    printf("%-24s %-9s %10.1f %10.1f %7lu %12llu %8.1f  %-11s", row.instance.c_str(), row.algorithm.c_str(),
+        row.median, row.fastest, row.size, row.calls, row.peakMemory, row.status.c_str());
+    if (base != nullptr && base->median > 0.0) {
+        printf(" %+7.1f%%", (row.median / base->median - 1.0) * 100.0);
+    }
+    if (!row.regression.empty()) {
+        printf("  REGRESSION: %s", row.regression.c_str());
+    }
+    printf("\n");
+}
+
+bool saveCSV(const vector<benchRow> &rows, const char *path)
+{
+    FILE *file {fopen(path, "w")};
+    if (file == nullptr) return false;
+    fprintf(file, "instance,algorithm,runs,setup_ms,median_ms,min_ms,max_ms,size,calls,peak_mb,status,regression\n");
+    for (auto &row : rows) {
+        fprintf(file, "%s,%s,%u,%.3f,%.3f,%.3f,%.3f,%lu,%llu,%.1f,%s,%s\n", row.instance.c_str(),
+            row.algorithm.c_str(), row.runs, row.setup, row.median, row.fastest, row.slowest, row.size, row.calls,
+            row.peakMemory, row.status.c_str(), row.regression.c_str());
+    }
+    fclose(file);
+    return true;
+}
+
+bool saveJSON(const vector<benchRow> &rows, const char *path, unsigned runs, unsigned warmup, const char *baseline)
+{
+    FILE *file {fopen(path, "w")};
+    if (file == nullptr) return false;
+    char date[32];
+    time_t now {time(nullptr)};
+    strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", gmtime(&now));
+    fprintf(file, "{\n  \"date\": \"%s\",\n  \"runs\": %u,\n  \"warmup\": %u,\n  \"baseline\": ", date, runs, warmup);
+    if (baseline != nullptr) {
+        fprintf(file, "\"%s\",\n", baseline);
+    } else {
+        fprintf(file, "null,\n");
+    }
+    fprintf(file, "  \"results\": [");
+    for (cardinal i = 0; i < rows.size(); ++i) {
+        const benchRow &row {rows[i]};
+        fprintf(file, "%s\n    {\"instance\": \"%s\", \"algorithm\": \"%s\", \"runs\": %u, \"setup_ms\": %.3f, "
+            "\"median_ms\": %.3f, \"min_ms\": %.3f, \"max_ms\": %.3f, \"size\": %lu, \"calls\": %llu, "
+            "\"peak_mb\": %.1f, \"status\": \"%s\", \"regression\": ", (i > 0) ? "," : "", row.instance.c_str(),
+            row.algorithm.c_str(), row.runs, row.setup, row.median, row.fastest, row.slowest, row.size, row.calls,
+            row.peakMemory, row.status.c_str());
+        if (row.regression.empty()) {
+            fprintf(file, "null}");
+        } else {
+            fprintf(file, "\"%s\"}", row.regression.c_str());
+        }
+    }
+    fprintf(file, "\n  ]\n}\n");
+    fclose(file);
+    return true;
+}
+
+void printHelp()
+{
+    printf("Usage: ./SuiteBench manifest.txt [ --runs NUMBER ] [ --warmup NUMBER ] [ --csv FILE ] [ --json FILE ]\n"
+           "                                 [ --baseline FILE ] [ --threshold PERCENT ]\n\n"
+           "    --runs NUMBER       Measured runs of each algorithm on each instance (%d by default)\n"
+           "    --warmup NUMBER     Runs before them, that are not measured (%d by default)\n"
+           "    --csv FILE          Save the results as CSV (the format of the baseline)\n"
+           "    --json FILE         Save the results as JSON\n"
+           "    --baseline FILE     Compare the results with the CSV of an earlier run\n"
+           "    --threshold PERCENT Slowdown over the baseline that counts as a regression (%.0f%% by default)\n\n"
+           "Each line of the manifest: FILE ALGORITHMS [ DEADLINE ], with a comma-separated list of algorithms\n"
+           "(mdg, vsa, mvsa, best, portfolio, exact, bitset), and the deadline of the exact ones (%.0f s by default).\n"
+           "The exit status is 1 when a regression was found, or when a run failed.\n",
+           DEFAULT_RUNS, DEFAULT_WARMUP, DEFAULT_THRESHOLD, DEFAULT_DEADLINE);
+}
+
+int main(int argc, char * argv[])
+{
+    unsigned runs {DEFAULT_RUNS}, warmup {DEFAULT_WARMUP};
+    double threshold {DEFAULT_THRESHOLD};
+    char *csvFile {nullptr}, *jsonFile {nullptr}, *baselineFile {nullptr};
+    const struct option longOptions[] = {
+        {"help",      no_argument,       nullptr, 'h'},
+        {"runs",      required_argument, nullptr, 'r'},
+        {"warmup",    required_argument, nullptr, 'w'},
+        {"csv",       required_argument, nullptr, 'c'},
+        {"json",      required_argument, nullptr, 'j'},
+        {"baseline",  required_argument, nullptr, 'b'},
+        {"threshold", required_argument, nullptr, 't'},
+        {nullptr, 0, nullptr, 0}
+    };
+    int opt;
+    while ((opt = getopt_long(argc, argv, "hr:w:c:j:b:t:", longOptions, nullptr)) != -1) {
+        switch (opt) {
+            case 'r': runs = max(atoi(optarg), 1); break;
+            case 'w': warmup = max(atoi(optarg), 0); break;
+            case 'c': csvFile = optarg; break;
+            case 'j': jsonFile = optarg; break;
+            case 'b': baselineFile = optarg; break;
+            case 't': threshold = atof(optarg); break;
+            case 'h':
+            default:
+                printHelp();
+                return 1;
+        }
+    }
+    if (optind >= argc) {
+        printHelp();
+        return 1;
+    }
+
+    vector<manifestEntry> entries {readManifest(argv[optind])};
+    map<string, benchRow> baseline;
+    if (baselineFile != nullptr) baseline = readBaseline(baselineFile);
+    printf("%lu instances, median of %u runs (after %u warm-up runs)%s%s\n\n", entries.size(), runs, warmup,
+        (baselineFile != nullptr) ? ", against " : "", (baselineFile != nullptr) ? baselineFile : "");
+    printf("%-24s %-9s %10s %10s %7s %12s %8s  %-11s%s\n", "instance", "algorithm", "median ms", "min ms", "size",
+        "calls", "peak MB", "status", (baselineFile != nullptr) ? " baseline" : "");
+
+    vector<benchRow> rows;
+    unsigned regressions {0};
+    for (auto &entry : entries) {
+        for (auto algo : entry.algorithms) {
+            benchRow row {measure(entry, algo, runs, warmup)};
+            auto base = baseline.find(row.instance + "," + row.algorithm);
+            if (row.status == "failed" || row.status == "invalid") {
+                row.regression = row.status;    // with or without a baseline
+            } else if (base != baseline.end()) {
+                compare(row, base->second, threshold);
+            }
+            if (!row.regression.empty()) ++regressions;
+            printRow(row, (base != baseline.end()) ? &base->second : nullptr);
+            rows.push_back(row);
+        }
+    }
+
+    if (csvFile != nullptr && !saveCSV(rows, csvFile)) {
+        fprintf(stderr, "Error: unable to write %s\n", csvFile);
+    }
+    if (jsonFile != nullptr && !saveJSON(rows, jsonFile, runs, warmup, baselineFile)) {
+        fprintf(stderr, "Error: unable to write %s\n", jsonFile);
+    }
+    if (baselineFile != nullptr) {
+        printf("\n%u regression(s) over %.0f%% against %s\n", regressions, threshold, baselineFile);
+    } else if (regressions > 0) {
+        printf("\n%u run(s) failed\n", regressions);
+    }
+    return (regressions > 0) ? 1 : 0;
+}
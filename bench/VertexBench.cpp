@@ -0,0 +1,114 @@
+// Project: Maximum Independent Set (MIS, version 5)
+// Computer Science (2016-2017), 4th semester
+// Author: Guillaume Cocatre-Zilgien
+// Professor: Michel Ventou
+
+// Compares the implementations of the vertices (how each vertex keeps its neighbors) on the same graph: the graph is
+// built from its list of edges, the MDG heuristic is run, and the result is validated (by looking at the neighbors of
+// every vertex of the set). Each step is repeated, and the fastest run is kept.
+
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include "BasicGraph.hpp"
+#include "Graph.hpp"
+#include "Timer.hpp"
+
+using namespace std;
+
+#define DEFAULT_RUNS 5
+#define BITSET_MAX_VERTICES 32768               // larger graphs would need too much memory for BitsetVertex
+
+typedef struct {
+    double build;                               // milliseconds taken to build the graph from its list of edges
+    double heuristic;                           // milliseconds taken by the MDG heuristic
+    double check;                               // milliseconds taken to check the result
+    cardinal size;                              // cardinality of the result
+    bool valid;                                 // is the result an independent set?
+} benchResult;
+
+void printResult(const char *name, const benchResult &r)
+{
+    printf("%-14s %10.2f %10.2f %10.2f %8lu  %s\n", name, r.build, r.heuristic, r.check, r.size,
+        r.valid ? "valid" : "INVALID");
+}
+
+template <typename VertexType>
+void benchmark(const char *name, cardinal n, const vector<vidPair> &edges, unsigned runs)
+{
+    benchResult r {0.0, 0.0, 0.0, 0, true};
+    for (unsigned run = 0; run < runs; ++run) {
+        Timer t;
+        BasicGraph<VertexType> g(n, edges);
+        double build {t.countMilliseconds()};
+        BasicGraph<VertexType> original(g);
+        t.reset();
+        vidSet set {g.findMaxDegreeMIS()};
+        double heuristic {t.countMilliseconds()};
+        t.reset();
+        r.valid = original.checkMIS(set) && r.valid;
+        double check {t.countMilliseconds()};
+        if (run == 0 || build < r.build) r.build = build;
+        if (run == 0 || heuristic < r.heuristic) r.heuristic = heuristic;
+        if (run == 0 || check < r.check) r.check = check;
+        r.size = set.size();
+    }
+    printResult(name, r);
+}
+
+// Graph itself (CSRVertex): the heuristic runs on the graph as built, as it does for the other implementations
+void benchmarkGraph(cardinal n, const vector<vidPair> &edges, unsigned runs)
+{
+    benchResult r {0.0, 0.0, 0.0, 0, true};
+    for (unsigned run = 0; run < runs; ++run) {
+        Timer t;
+        Graph g(n, edges);
+        double build {t.countMilliseconds()};
+        Graph original(g);
+        t.reset();
+        vidSet set {g.findHeuristicMIS(ALGO_MDG)};
+        double heuristic {t.countMilliseconds()};
+        t.reset();
+        r.valid = original.checkMIS(set) != MIS_INVALID && r.valid;
+        double check {t.countMilliseconds()};
+        if (run == 0 || build < r.build) r.build = build;
+        if (run == 0 || heuristic < r.heuristic) r.heuristic = heuristic;
+        if (run == 0 || check < r.check) r.check = check;
+        r.size = set.size();
+    }
+    printResult("CSRVertex", r);
+}
+
+int main(int argc, char * argv[])
+{
+    if (argc < 2) {
+        fprintf(stderr, "Usage: ./VertexBench graph.txt [ RUNS ]\n");
+        return 1;
+    }
+    unsigned runs {(argc > 2) ? (unsigned) atoi(argv[2]) : DEFAULT_RUNS};
+    if (runs < 1) runs = 1;
+
+    Graph file(argv[1]);
+    cardinal n {file.getSize()};
+    if (n == 0) return 1;
+    vector<vidPair> edges;
+    for (vid v = 0; v < n; ++v) {
+        for (auto &w : file.getNeighbors(v)) {
+            if (v < w) edges.push_back(make_pair(v, w));
+        }
+    }
+    printf("%lu vertices, %lu edges, best of %u runs\n\n", n, edges.size(), runs);
+    printf("%-14s %10s %10s %10s %8s\n", "Vertex", "build (ms)", "MDG (ms)", "check (ms)", "MIS");
+
+    benchmarkGraph(n, edges, runs);
+    benchmark<VectorVertex>("VectorVertex", n, edges, runs);
+    benchmark<SortedVectorVertex>("SortedVector", n, edges, runs);
+    benchmark<ListVertex>("ListVertex", n, edges, runs);
+    benchmark<SetVertex>("SetVertex", n, edges, runs);
+    if (n <= BITSET_MAX_VERTICES) {
+        benchmark<BitsetVertex>("BitsetVertex", n, edges, runs);
+    } else {
+        printf("%-14s (skipped: more than %d vertices)\n", "BitsetVertex", BITSET_MAX_VERTICES);
+    }
+    return 0;
+}
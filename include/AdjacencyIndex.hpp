@@ -0,0 +1,44 @@
+// Project: Maximum Independent Set (MIS, version 5)
+// Computer Science (2016-2017), 4th semester
+// Author: Guillaume Cocatre-Zilgien
+// Professor: Michel Ventou
+
+#ifndef AdjacencyIndex_hpp
+#define AdjacencyIndex_hpp
+
+#include <cstdint>
+#include <vector>
+#include "Vertex.hpp"
+
+const std::size_t DEFAULT_MATRIX_THRESHOLD = 4096; // largest graph indexed by an adjacency matrix (2 MB)
+
+// Answers "are v and w connected?" in O(1), instead of looking for w among the neighbors of v.
+// Graphs with few vertices get an adjacency matrix (one bit per pair of vertices); larger graphs get a hash set of
+// their edges (open addressing, linear probing), which only takes memory for the edges that exist.
+class AdjacencyIndex
+{
+public:
+    typedef std::uint64_t word;
+protected:
+    bool matrix;                                // adjacency matrix (true) or hash set (false)?
+    std::size_t threshold;                      // matrix: largest number of rows
+    std::size_t rows;                           // matrix: number of vertices it has room for
+    std::size_t words;                          // matrix: number of words per row
+    std::vector<word> bits;                     // matrix: rows of bits, one per vertex
+    std::vector<word> slots;                    // hash set: edges (smallest vertex in the high half), or markers
+    std::size_t used;                           // hash set: number of slots that are not empty (edges and tombstones)
+    std::size_t mask;                           // hash set: number of slots - 1 (a power of 2)
+
+    static word getKey(vid v, vid w)            { return (v < w) ? ((word) v << 32) | w : ((word) w << 32) | v; }
+    std::size_t getSlot(word key) const         { return (key * 0x9E3779B97F4A7C15ULL >> 32) & this->mask; }
+    void resize(std::size_t);                   // hash set: move every edge into a new table of slots
+public:
+    AdjacencyIndex(std::size_t, std::size_t, std::size_t); // vertices, edges, largest number of vertices of a matrix
+    bool isMatrix()                             { return this->matrix; }
+    bool grow(std::size_t);                     // make room for a number of vertices (false: too many for a matrix)
+    void insert(vid, vid);
+    void erase(vid, vid);
+    bool contains(vid, vid) const;
+};
+
+#endif /* AdjacencyIndex_hpp */
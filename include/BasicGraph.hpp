@@ -0,0 +1,135 @@
+// Project: Maximum Independent Set (MIS, version 5)
+// Computer Science (2016-2017), 4th semester
+// Author: Guillaume Cocatre-Zilgien
+// Professor: Michel Ventou
+
+#ifndef BasicGraph_hpp
+#define BasicGraph_hpp
+
+#include <vector>
+#include "Graph.hpp"
+
+// Graph whose vertices keep their own neighbors, in any implementation of GenericVertex (ListVertex, VectorVertex,
+// SortedVectorVertex, SetVertex or BitsetVertex). It only does what the MDG heuristic and the validation of a MIS
+// need, so that every implementation can be compared with the others, and with Graph (whose rows of neighbors are all
+// in one array), on the same graphs and in the same program (see bench/VertexBench.cpp).
+template <typename VertexType>
+class BasicGraph
+{
+protected:
+    std::vector<VertexType> vertices;           // set of vertices in the graph
+    unsigned numberOfEdges;                     // number of edges in the graph
+    std::vector<vid> buckets;                   // degree buckets: first enabled vertex of each degree
+    score maxDegree;                            // degree buckets: no enabled vertex has a higher degree
+    void linkVertex(vid);                       // add a vertex to the bucket of its degree
+    void unlinkVertex(vid, score);              // remove a vertex from the bucket of a given degree
+    vid getMaxDegreeVertex();                   // get a vertex with the highest degree
+public:
+    BasicGraph(cardinal, const std::vector<vidPair> &); // number of vertices, and list of edges
+    cardinal getSize()                          { return vertices.size(); }
+    unsigned getNumberOfEdges()                 { return numberOfEdges; }
+    void disableVertex(vid);                    // disable a vertex, and remove its edges
+    bool areVerticesConnected(vid v, vid w)     { return vertices[v].isConnectedTo(w); }
+    vidSet findMaxDegreeMIS();                  // MDG heuristic (the graph loses its edges)
+    bool checkMIS(const vidSet &);              // check the validity of a MIS
+};
+
+template <typename VertexType>
+BasicGraph<VertexType>::BasicGraph(cardinal n, const std::vector<vidPair> &edges) : numberOfEdges {0}, maxDegree {0}
+{
+    this->vertices.resize(n);
+    for (vid v = 0; v < n; ++v) {
+        this->vertices[v].id = v;
+    }
+    for (auto &edge : edges) {
+        this->vertices[edge.first].addNeighbor(edge.second);
+        this->vertices[edge.second].addNeighbor(edge.first);
+        ++this->numberOfEdges;
+    }
+    for (auto &vertex : this->vertices) {
+        if (vertex.degree > this->maxDegree) this->maxDegree = vertex.degree;
+    }
+    this->buckets.assign(this->maxDegree + 1, NO_VERTEX_FOUND);
+    for (vid v = 0; v < n; ++v) {
+        this->linkVertex(v);
+    }
+}
+
+// Same degree buckets as Graph::linkVertex()
+template <typename VertexType>
+void BasicGraph<VertexType>::linkVertex(vid v)
+{
+    VertexType &vertex {this->vertices[v]};
+    if (!vertex.enabled) return;
+    vid &head {this->buckets[vertex.degree]};
+    vertex.previous = NO_VERTEX_FOUND;
+    vertex.next = head;
+    if (head != NO_VERTEX_FOUND) this->vertices[head].previous = v;
+    head = v;
+}
+
+template <typename VertexType>
+void BasicGraph<VertexType>::unlinkVertex(vid v, score degree)
+{
+    VertexType &vertex {this->vertices[v]};
+    if (!vertex.enabled) return;
+    if (vertex.previous != NO_VERTEX_FOUND) {
+        this->vertices[vertex.previous].next = vertex.next;
+    } else {
+        this->buckets[degree] = vertex.next;
+    }
+    if (vertex.next != NO_VERTEX_FOUND) this->vertices[vertex.next].previous = vertex.previous;
+}
+
+template <typename VertexType>
+vid BasicGraph<VertexType>::getMaxDegreeVertex()
+{
+    while (this->maxDegree > 0 && this->buckets[this->maxDegree] == NO_VERTEX_FOUND) {
+        --this->maxDegree;
+    }
+    return (this->maxDegree > 0) ? this->buckets[this->maxDegree] : NO_VERTEX_FOUND;
+}
+
+template <typename VertexType>
+void BasicGraph<VertexType>::disableVertex(vid v)
+{
+    VertexType &vertex {this->vertices[v]};
+    this->unlinkVertex(v, vertex.degree);
+    this->numberOfEdges -= vertex.degree;
+    vertex.forEachNeighbor([this, v](vid w) {
+        VertexType &neighbor {this->vertices[w]};
+        this->unlinkVertex(w, neighbor.degree);
+        neighbor.removeNeighbor(v);
+        this->linkVertex(w);
+    });
+    vertex.disable();
+}
+
+template <typename VertexType>
+vidSet BasicGraph<VertexType>::findMaxDegreeMIS()
+{
+    vidSet set;
+    while (this->numberOfEdges > 0) {
+        this->disableVertex(this->getMaxDegreeVertex());
+    }
+    for (auto &vertex : this->vertices) {
+        if (vertex.isEnabled()) set.insert(vertex.id);
+    }
+    return set;
+}
+
+// Same walk over the neighbors as Graph::checkMIS() (without maximality)
+template <typename VertexType>
+bool BasicGraph<VertexType>::checkMIS(const vidSet &MIS)
+{
+    bool independent {true};
+    for (vid v : MIS) {
+        this->vertices[v].forEachNeighbor([&MIS, &independent](vid w) {
+            if (MIS.count(w) != 0) independent = false;
+        });
+        if (!independent) return false;
+    }
+    return true;
+}
+
+#endif /* BasicGraph_hpp */
@@ -0,0 +1,82 @@
+// Project: Maximum Independent Set (MIS, version 5)
+// Computer Science (2016-2017), 4th semester
+// Author: Guillaume Cocatre-Zilgien
+// Professor: Michel Ventou
+
+#ifndef BitGraph_hpp
+#define BitGraph_hpp
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "Graph.hpp"
+#include "Timer.hpp"
+
+typedef std::uint64_t word;
+
+const cardinal WORD_BITS = 64;
+
+// Second implementation of the exact algorithm: the set of remaining vertices and every row of the adjacency matrix
+// are fixed-width bitsets, so disabling a vertex (or a whole neighborhood) is a word-wide AND-NOT, and the degree of a
+// vertex is a popcount. Vertex IDs are the same as in the graph the bitsets were built from.
+//
+// A subproblem is nothing more than a set of remaining vertices and a list of selected vertices, which makes it easy
+// to hand over to another thread: each worker has its own deque of subproblems, and steals from the others when it
+// runs out. All workers share the cardinality of the largest MIS found so far, so they all prune with the same bound.
+class BitGraph
+{
+protected:
+    struct Task
+    {
+        std::vector<word> remaining;            // remaining vertices
+        std::vector<vid> selected;              // vertices selected so far
+    };
+    struct Worker
+    {
+        std::vector<word> remaining;            // remaining vertices, one bitset per recursion depth
+        std::vector<vid> selected;              // vertices selected along the current branch
+        std::deque<Task> tasks;                 // subproblems waiting to be solved (stolen from the front)
+        std::mutex lock;                        // protects the deque of tasks
+        unsigned long long numberOfCalls;       // number of recursive calls made by this worker
+        unsigned deadlineCountdown;             // number of calls until the clock is read again
+    };
+    cardinal size;                              // number of vertices
+    cardinal words;                             // number of 64-bit words in a bitset
+    std::vector<word> adjacency;                // adjacency matrix, one bitset per vertex
+    std::vector<word> root;                     // enabled vertices of the original graph
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::atomic<cardinal> bestSize;             // cardinality of the MIS, read by every worker
+    std::atomic<unsigned long long> pendingTasks; // number of tasks that were created but not solved yet
+    std::atomic<unsigned> idleWorkers;          // number of workers looking for a task
+    std::atomic<unsigned long long> sharedTasks; // number of tasks shared so far (idle workers wait for the next one)
+    std::mutex lockIdle;                        // protects the wait of the idle workers
+    std::condition_variable taskAvailable;      // notified when a task is shared, and when the last one is solved
+    std::mutex lockMIS;                         // protects the MIS
+    vidSet MIS;                                 // Maximum Independent Set
+    bool hasDeadline;                           // should the search stop at some point?
+    timePoint deadline;                         // point in time at which the search stops
+    std::atomic<bool> stopped;                  // did the search stop before the end?
+    cardinal openBound;                         // largest upper bound of the abandoned subproblems (protected by lockMIS)
+    word * getRow(vid v)                        { return &this->adjacency[v * this->words]; }
+    word * getRemaining(Worker &w, cardinal d)  { return &w.remaining[d * this->words]; }
+    score getDegree(vid, const word *);         // degree of a vertex within a set of remaining vertices
+    void updateMIS(const std::vector<vid> &);   // replace the MIS if the given set is larger
+    bool isPastDeadline(Worker &);              // has the deadline passed (the clock is not read every time)?
+    void abandon(cardinal);                     // give up on a subproblem, but keep its upper bound
+    bool getTask(Worker &, Task &);             // pop a task from a worker's deque, or steal one from another worker
+    void runWorker(Worker &);                   // solve tasks until there are none left
+    void search(Worker &, cardinal);            // exact algorithm
+public:
+    BitGraph(Graph &);
+    vidSet findMIS(const vidSet &, unsigned threads = 1); // find a MIS, larger than the one given (if any)
+    void setDeadline(timePoint d)               { this->hasDeadline = true; this->deadline = d; }
+    bool isStopped()                            { return this->stopped.load(); }
+    cardinal getUpperBound();                   // no MIS is larger than this
+    unsigned long long getNumberOfCalls();
+};
+
+#endif /* BitGraph_hpp */
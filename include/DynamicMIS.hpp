@@ -0,0 +1,61 @@
+// Project: Maximum Independent Set (MIS, version 5)
+// Computer Science (2016-2017), 4th semester
+// Author: Guillaume Cocatre-Zilgien
+// Professor: Michel Ventou
+
+#ifndef DynamicMIS_hpp
+#define DynamicMIS_hpp
+
+#include <istream>
+#include <string>
+#include <vector>
+#include "Graph.hpp"
+
+const unsigned DEFAULT_RESOLVE_INTERVAL = 10000; // number of updates between two full re-solves
+const double RESOLVE_DROP = 0.01;               // also solve again once the set is 1% smaller than after the last time
+const unsigned MIN_RESOLVE_GAP = 1000;          // but not before this number of updates since the last re-solve
+
+// Keeps an independent set of a graph maximal while the graph changes, one update at a time: "+e U V" and "-e U V" add
+// and remove an edge, "+v" adds an isolated vertex (numbered after the others), "-v U" removes a vertex (vertices are
+// numbered from 1, as in the files). After each update, only the vertices around it are looked at: the vertices that
+// lost their last neighbor in the set join it, and (1,2)-swaps (see LocalSearch) are tried around them, so the set
+// can also grow. Those local repairs slowly fall behind, so the whole graph is solved again from time to time
+// (Graph::findMIS(ALGO_BEST)), and the result replaces the set if it is larger.
+class DynamicMIS
+{
+protected:
+    Graph &graph;
+    std::vector<bool> inSet;                    // is a vertex part of the set?
+    std::vector<score> tightness;               // number of neighbors of a vertex in the set
+    std::vector<vid> mate;                      // XOR of the neighbors of a vertex in the set (the one, if 1-tight)
+    cardinal size;                              // number of vertices in the set
+    std::vector<vid> touched;                   // vertices around the current update
+    std::vector<vid> candidates;                // vertices of the set that may allow a (1,2)-swap
+    std::vector<bool> queued;                   // is a vertex in the list of candidates?
+    std::vector<vid> oneTight;                  // scratch list (see swapVertex())
+    std::vector<unsigned> marks;                // scratch marks, valid when equal to the current stamp
+    unsigned stamp;
+    unsigned resolveInterval;                   // 0: only when the set gets too small
+    cardinal resolvedSize;                      // size of the set after the last re-solve
+    unsigned long long sinceResolve;            // number of updates since the last re-solve
+    std::vector<double> latencies;              // microseconds taken by each update (with the re-solve it caused)
+    unsigned long long numberOfUpdates, numberOfIgnored, numberOfSwaps, numberOfResolves;
+    double resolveSeconds;
+
+    void reset(const vidSet &);                 // make a set the current one
+    void addToSet(vid);
+    void removeFromSet(vid);                    // the neighbors of the vertex are touched
+    void enqueue(vid);                          // add a vertex of the set to the list of candidates
+    bool swapVertex(vid);                       // look for a (1,2)-swap around a vertex of the set, and apply it
+    void repair();                              // make the set maximal again around the touched vertices
+    double resolve();                           // solve the whole graph again (returns the seconds it took)
+    void printRow();                            // size of the graph and of the set so far
+public:
+    DynamicMIS(Graph &, unsigned);              // graph, and number of updates between two re-solves
+    bool update(const std::string &);           // apply one update (false: malformed, or impossible)
+    void run(std::istream &);                   // apply every update of a stream, then print the statistics
+    vidSet getSet() const;
+    cardinal getSize() const                    { return this->size; }
+};
+
+#endif /* DynamicMIS_hpp */
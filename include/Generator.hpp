@@ -0,0 +1,53 @@
+// Project: Maximum Independent Set (MIS, version 5)
+// Computer Science (2016-2017), 4th semester
+// Author: Guillaume Cocatre-Zilgien
+// Professor: Michel Ventou
+
+#ifndef Generator_hpp
+#define Generator_hpp
+
+#include <functional>
+#include <random>
+#include <vector>
+#include "Graph.hpp"
+
+const unsigned GENERATOR_CHUNKS = 256;          // parts of the work, each with its own random numbers
+const double DEFAULT_AVERAGE_DEGREE = 10.0;     // of the graphs generated with --model, without -p or --degree
+const double POWER_LAW_EXPONENT = 2.5;          // Chung-Lu: the number of vertices of degree d is about d^(-2.5)
+const double RMAT_A = 0.57, RMAT_B = 0.19, RMAT_C = 0.19; // R-MAT: quadrant probabilities (the last one is 0.05)
+
+// Random graphs, in time linear in their number of edges (not in the number of pairs of vertices):
+//
+// - G(n, p): every pair of vertices is connected with probability p; the pairs that are not connected are skipped,
+//   a geometric number of them at a time (Batagelj & Brandes).
+// - G(n, m): m pairs of vertices drawn at random, without repetition (the complement is drawn for dense graphs).
+// - Random geometric: vertices at random in the unit square, connected when they are closer than a radius; each
+//   vertex is only compared with the vertices of its own cell of a grid, and of the next ones.
+// - Chung-Lu: the expected degrees of the vertices follow a power law, and u and v are connected with a probability
+//   proportional to the product of their expected degrees; skipping as in G(n, p) (Miller & Hagberg).
+// - R-MAT: each edge falls recursively into one of the four quadrants of the adjacency matrix (Chakrabarti, Zhan &
+//   Faloutsos); repeated edges are dropped when the graph is built.
+//
+// The work is cut into GENERATOR_CHUNKS parts, that threads take in turn, and the random numbers of each part only
+// depend on the seed and on the part: the same seed gives the same graph, whatever the number of threads.
+class Generator
+{
+protected:
+    cardinal n;
+    unsigned long long seed;
+    unsigned threads;
+    std::vector<std::vector<vidPair>> chunks;   // edges generated by each part
+    void runChunks(const std::function<void(unsigned, std::mt19937_64 &, std::vector<vidPair> &)> &);
+    std::vector<vidPair> collect();             // edges of every part, in the order of the parts
+public:
+    Generator(cardinal, unsigned long long, unsigned threads = 0); // vertices, seed, threads (0: one per core)
+    std::vector<vidPair> generate(graphModel, double); // model, and average degree
+    std::vector<vidPair> generateGnp(double);   // probability of each edge
+    std::vector<vidPair> generateGnm(unsigned long long); // number of edges
+    std::vector<vidPair> generateGeometric(double); // average degree
+    std::vector<vidPair> generateChungLu(double); // average degree
+    std::vector<vidPair> generateRMAT(unsigned long long); // number of edges (before repeated ones are dropped)
+    static const char * getName(graphModel);
+};
+
+#endif /* Generator_hpp */
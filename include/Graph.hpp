@@ -8,76 +8,229 @@
 
 #include <algorithm>
 #include <limits>
+#include <memory>
+#include <random>
 #include <utility>
 #include <vector>
-#include <set>
+#include "AdjacencyIndex.hpp"
+#include "IndexedHeap.hpp"
+#include "Timer.hpp"
 #include "Vertex.hpp"
+#include "VertexSet.hpp"
 
 // Here we decide which implementation we want to use:
 // typedef ListVertex Vertex;
 // typedef SetVertex Vertex;
-typedef VectorVertex Vertex;
+// typedef VectorVertex Vertex;
+// Those three kept their own neighbors; the graph now keeps every row of neighbors in one array (see CSRVertex).
+typedef CSRVertex Vertex;
 
 typedef std::size_t cardinal;
 typedef std::pair<vid, vid> vidPair;
-typedef std::set<vid> vidSet;
+typedef VertexSet vidSet;                       // was std::set<vid> (see VertexSet)
+typedef std::pair<score, score> supportKey;     // support and degree of a vertex (see Graph::getMaxSupportVertex())
+
+// Saved state of a vertex in the clique cover (see Graph::coverWithCliques())
+typedef struct {
+    vid v;
+    vid clique;
+    cardinal size;
+} cliqueEntry;
+
+// Degree 2 fold: v, u and w were folded into u (see Reducer::reduceFold())
+typedef struct {
+    vid v;
+    vid u;
+    vid w;
+} foldEntry;
 
 const unsigned RANDOM_NUMBER_OF_VERTICES = std::numeric_limits<unsigned>::max();
 const unsigned NO_VERTEX_FOUND = std::numeric_limits<unsigned>::max();
 const unsigned SCORE_LIMIT = std::numeric_limits<unsigned>::max();
 const std::size_t BAD_MIS = 0;
+const std::size_t PARALLEL_COMPONENT_SIZE = 64; // components at least this large are solved in separate threads
+const unsigned DEADLINE_CHECK_INTERVAL = 256;   // number of branches between two readings of the clock
+const unsigned long long DEFAULT_SEARCH_ITERATIONS = 20000; // number of iterations of the local search
+const double DEFAULT_PORTFOLIO_TIME = 1.0;      // number of seconds of the portfolio of heuristics
+const cardinal PARALLEL_CHECK_SIZE = 1 << 16;  // graphs at least this large are checked by several threads
+const cardinal SMALL_GRAPH_SIZE = 128;          // subgraphs this small are solved on bitsets (at most 128, see SmallMIS)
+const std::size_t DEFAULT_TABLE_SIZE = 64 << 20; // size of the transposition table, in bytes
+const cardinal DEFAULT_TABLE_THRESHOLD = 64;    // largest subgraph (number of vertices) stored in the table
+const std::size_t TABLE_SIZE_PER_VERTEX = 1 << 10; // small graphs get smaller tables
+const score MIN_ROW_CAPACITY = 4;               // smallest row of neighbors, once it has to grow (see addNeighbor())
+
+enum algorithm {ALGO_EXACT, ALGO_EXACT_BITSET, ALGO_MDG, ALGO_VSA, ALGO_MVSA, ALGO_BEST, ALGO_PORTFOLIO,
+                ALGO_ENUM_SIZE};
+enum misCheck {MIS_INVALID, MIS_NOT_MAXIMAL, MIS_MAXIMAL}; // see Graph::checkMIS()
+enum ordering {ORDER_NONE, ORDER_DEGENERACY, ORDER_RCM, ORDER_BFS, ORDER_ENUM_SIZE}; // see Ordering
+enum graphModel {MODEL_GNM, MODEL_GNP, MODEL_GEOMETRIC, MODEL_CHUNG_LU, MODEL_RMAT, MODEL_ENUM_SIZE}; // see Generator
 
-enum algorithm {ALGO_EXACT, ALGO_MDG, ALGO_VSA, ALGO_MVSA, ALGO_BEST, ALGO_ENUM_SIZE};
+class Reducer;
+class LocalSearch;
+class GraphLoader;
+class TranspositionTable;
 
 class Graph
 {
+    friend class Reducer;
+    friend class LocalSearch;
 private:
     unsigned long long numberOfCalls;           // number of recursive calls for the exact algorithm
+    unsigned long long numberOfCuts;            // number of branches cut by the clique cover bound
+    unsigned long long numberOfTableHits;       // number of subgraphs answered by the transposition table
+    unsigned long long numberOfTableMisses;     // number of subgraphs that were looked up in vain
 protected:
     std::vector<Vertex> vertices;               // set of vertices in the graph
+    std::vector<vid> adjacency;                 // rows of neighbors of every vertex, one after the other (see CSRVertex)
+    cardinal unusedEntries;                     // entries of the rows that had to move to the end of the adjacency array
+    std::shared_ptr<AdjacencyIndex> adjacencyIndex; // edges, for areVerticesConnected() (shared by copies, see below)
+    cardinal matrixThreshold;                   // largest graph whose index is an adjacency matrix
     unsigned numberOfEdges;                     // number of edges in the graph
     cardinal enabledCardinal;                   // number of vertices that were NOT disabled
     vidSet MIS;                                 // Maximum Independent Set
+    cardinal lowerBound;                        // exact algorithm: only sets larger than this are looked for
+    std::vector<vidPair> trail;                 // removed edges, and disabled vertices paired with NO_VERTEX_FOUND
+    bool recordTrail;                           // are removals recorded in the trail (exact algorithm only)?
+    unsigned numberOfThreads;                   // number of threads for the exact algorithm on bitsets
+    std::vector<vid> cliqueOf;                  // clique cover: clique of each vertex (named after its first vertex)
+    std::vector<cardinal> cliqueSize;           // clique cover: number of enabled vertices in each clique
+    std::vector<cardinal> cliqueHits;           // clique cover: scratch counters used while building a cover
+    std::vector<cliqueEntry> coverTrail;        // clique cover: previous covers, restored when backtracking
+    cardinal numberOfCliques;                   // clique cover: number of non-empty cliques (bounds the MIS)
+    std::vector<foldEntry> folds;               // vertices folded by the reductions, in order
+    std::vector<vid> componentIndex;            // connected components: component (or index) of each vertex
+    std::vector<vid> componentQueue;            // connected components: breadth-first search queue
+    std::vector<vid> buckets;                   // degree buckets: first enabled vertex of each degree
+    score maxDegree;                            // degree buckets: no enabled vertex has a higher degree
+    cardinal kernelCardinal;                    // number of enabled vertices with at least one neighbor
+    TranspositionTable *table;                  // transposition table: shared by the components (nullptr: none)
+    std::size_t tableSize;                      // transposition table: size in bytes (0: no table)
+    cardinal tableThreshold;                    // transposition table: largest subgraph that is stored
+    bool hasDeadline;                           // deadline: should the exact algorithm stop at some point?
+    timePoint deadline;                         // deadline: point in time at which the exact algorithm stops
+    unsigned deadlineCountdown;                 // deadline: number of branches until the clock is read again
+    bool stopped;                               // deadline: did the exact algorithm stop before the end?
+    cardinal openBound;                         // deadline: largest upper bound of the branches that were abandoned
+    bool recordSupports;                        // supports: are supports updated when vertices are disabled?
+    std::vector<score> supports;                // supports: sum of the degrees of the neighbors of each vertex
+    std::vector<score> supportDegrees;          // supports: degree of each vertex, side by side (see computeSupports())
+    IndexedHeap<supportKey, std::greater<supportKey>> maxSupportHeap; // supports: highest support first (VSA)
+    IndexedHeap<score> minSupportHeap;          // supports: smallest support first (MVSA)
+    std::vector<vid> minSupportVertices;        // supports: scratch list (see getMinSupportVertexNeighbor())
+    std::vector<vid> changedSupports;           // supports: vertices whose support changed (see updateSupports())
+    std::vector<bool> supportChanged;           // supports: is a vertex in that list?
+    unsigned long long searchIterations;        // local search: number of iterations (see LocalSearch)
+    double searchSeconds;                       // local search: number of seconds (0: no time limit)
+    unsigned portfolioThreads;                  // portfolio: number of threads (see findPortfolioMIS())
+    double portfolioSeconds;                    // portfolio: number of seconds
+    unsigned long long numberOfRestarts;        // portfolio: number of heuristics that were run
+    unsigned seed;                              // seed of the local search (and of the random numbers below)
+    std::mt19937 rng;                           // random numbers of this graph (generation, portfolio)
+    std::vector<vid> originalID;                // relabeling: ID of each vertex in the file (empty: not relabeled)
+    vid * getRow(vid v)                         { return this->adjacency.data() + this->vertices[v].offset; }
+    void addNeighbor(vid, vid);                 // add a neighbor to a row (the row moves if it is full)
+    void removeNeighbor(vid, vid);              // move a neighbor to the removed part of a row
+    void restoreNeighbor(vid, vid);             // put back the last neighbor that was removed from a row
+    void buildAdjacency(const std::vector<vidPair> &); // build every row at once, from a list of edges
+    void compactAdjacency();                    // copy the rows into a new array, without any unused entry
+    void loadSnapshot(const GraphLoader &);     // take the rows and the buckets of a snapshot as they are
+    void indexAdjacency();                      // build the index of the edges again
+    AdjacencyIndex * getWritableIndex();        // the index, copied first if another graph shares it (or nullptr)
+    void initializeBuckets();                   // put every enabled vertex in the bucket of its degree
+    void linkVertex(vid);                       // add a vertex to the bucket of its degree
+    void unlinkVertex(vid, score);              // remove a vertex from the bucket of a given degree
+    void initializeSupports(algorithm);         // compute every support, for the VSA or the MVSA heuristic
+    void computeSupports();                     // compute every support again, and rebuild the support heaps
+    void updateSupports(vid);                   // the edges of a vertex were removed (see disableVertex())
+    bool isPastDeadline();                      // has the deadline passed (the clock is not read every time)?
+    void abandonBranch(cardinal bound)          { if (bound > this->openBound) this->openBound = bound; }
     void constructMIS(vidSet &);                // build a MIS from the list of enabled vertices
     void disableVertex(vid);                    // disable a vertex
     void disableVertexNeighborhood(vid);        // disable the neighbors of a vertex
-    void restoreVertex(Vertex &);               // re-enable a vertex
-    Vertex & getNeighborByIndex(vid v, int i)   {
-        auto it = vertices[v].neighbors.cbegin();
-        std::advance(it, i);
-        return vertices[*it];
-    }
-    vid getVertexOfDegree(score);               // get a vertex with a degree of a certain value
-    vidPair getTwinVertices();                  // get a couple of "obvious" vertices for the exact algorithm
+    cardinal getTrailMark()                     { return this->trail.size(); }
+    void rollback(cardinal);                    // undo every removal recorded in the trail after a mark
+    void initializeCover();                     // trivial clique cover (one clique per vertex)
+    void coverWithCliques();                    // greedy clique cover of the enabled vertices
+    void restoreCover(cardinal);                // restore the clique cover that was saved before a mark
     vid getMaxDegreeVertex();                   // get a vertex with the highest degree
     vid getMaxSupportVertex();                  // get a vertex with the highest support value (for the VSA heuristic)
     vid getMinSupportVertexNeighbor();          // get a vertex with the smallest support value (for the MVSA heuristic)
     unsigned getRandomNumber(unsigned, unsigned);
-    cardinal processObviousVertex(std::vector<Vertex> &); // process "obvious" vertices for the exact algorithm
-    cardinal processTwinVertices(std::vector<Vertex> &);  // same as above
-    cardinal findExactMIS();                    // exact algorithm
+    Graph extractSubgraph(const std::vector<vid> &); // copy the subgraph induced by some vertices
+    bool findComponentsMIS(cardinal &);         // solve each connected component separately (exact algorithm)
+    template <unsigned Words>
+    cardinal findSmallMIS();                    // solve the remaining subgraph on fixed-width bitsets (exact algorithm)
+    cardinal findExactMIS(Reducer &);           // exact algorithm
+    cardinal runExactMIS(Reducer &, cardinal);  // set up the exact algorithm, and look for a set larger than a bound
+    void copyPermuted(const Graph &, const std::vector<vid> &); // copy a graph, with its vertices in another order
+    void runHeuristic(algorithm);               // disable vertices with a heuristic until no edges remain
+    vidSet findPortfolioMIS();                  // restart randomized heuristics on several threads
+    vidSet improveMIS(const vidSet &);          // improve an independent set with a local search
+    vidSet findKernelMIS(algorithm);            // find a MIS of the reduced graph
+    vidSet restoreIDs(const vidSet &);          // turn the IDs of a relabeled graph back into the original ones
 public:
-    Graph()                                     : numberOfEdges {0}, enabledCardinal {0} {}
+    Graph()                                     : numberOfCalls {0}, numberOfCuts {0}, numberOfTableHits {0},
+                                                  numberOfTableMisses {0}, unusedEntries {0},
+                                                  matrixThreshold {DEFAULT_MATRIX_THRESHOLD}, numberOfEdges {0},
+                                                  enabledCardinal {0}, lowerBound {0}, recordTrail {false},
+                                                  numberOfThreads {1}, numberOfCliques {0}, maxDegree {0},
+                                                  kernelCardinal {0}, table {nullptr}, tableSize {DEFAULT_TABLE_SIZE},
+                                                  tableThreshold {DEFAULT_TABLE_THRESHOLD}, hasDeadline {false},
+                                                  deadlineCountdown {0}, stopped {false}, openBound {0},
+                                                  recordSupports {false}, searchIterations {DEFAULT_SEARCH_ITERATIONS},
+                                                  searchSeconds {0.0}, portfolioThreads {1},
+                                                  portfolioSeconds {DEFAULT_PORTFOLIO_TIME}, numberOfRestarts {0},
+                                                  seed {std::mt19937::default_seed} {}
     Graph(cardinal);
+    Graph(cardinal, const std::vector<vidPair> &); // number of vertices, and list of edges
     Graph(const char *path);
+    Graph(const GraphLoader &);                 // graph read from a file (see GraphLoader)
     void print();
     Vertex & operator[](vid v)                  { return vertices.at(v); }
+    NeighborRange getNeighbors(vid v) const {
+        const vid *row {this->adjacency.data() + this->vertices[v].offset};
+        return NeighborRange(row, row + this->vertices[v].degree);
+    }
     cardinal getSize()                          { return vertices.size(); }
     unsigned getNumberOfEdges()                 { return numberOfEdges; }
-    unsigned getMaxNumberOfEdges()              { return (unsigned) ((vertices.size() * (vertices.size() - 1 )) / 2); }
+    unsigned long long getMaxNumberOfEdges()    { return (vertices.size() * (vertices.size() - 1 )) / 2; }
     float getNumberOfEdgesPerVertex()           { return 2.0 * numberOfEdges / vertices.size(); }
     float getEdgePercentage()                   { return (numberOfEdges * 100.0 / this->getMaxNumberOfEdges()); }
     bool isIndependent()                        { return (numberOfEdges == 0); }
     vidSet getMIS()                             { return MIS; }
-    unsigned connectRandomly(float);            // generate a graph randomly
+    unsigned connectRandomly(float);            // generate a graph randomly (percentage of the possible edges)
+    unsigned connectRandomly(graphModel, double); // generate a graph with a model and an average degree
+    void setSeed(unsigned s)                    { seed = s; rng.seed(s); }
     void connectVertices(vid, vid);             // connect two vertices with an edge
     void disconnectVertices(vid, vid);          // disconnect two vertices (remove the edge)
     void disconnectVertex(vid);                 // disconnect a vertex from its neighbors
+    vid addVertex();                            // add an isolated vertex (the IDs of the others do not change)
+    void removeVertex(vid);                     // disconnect a vertex, and disable it for good
+    bool isVertexEnabled(vid v) const           { return vertices[v].enabled; }
+    void clearMIS()                             { MIS.clear(); } // forget the best MIS so far (the graph has changed)
     bool areVerticesConnected(vid, vid);        // are these two vertices connected by an edge?
     vidSet findMIS(algorithm);                  // find a Maximum Independent Set
-    bool checkMIS(const vidSet &);              // check the validity of a MIS
+    vidSet liftMIS(vidSet);                     // turn a MIS of the reduced graph into a MIS of the original graph
+    void relabel(ordering);                     // renumber the vertices (before any reduction, see Ordering)
+    double timeHeuristic(algorithm);            // milliseconds taken by a heuristic on a copy of the graph
+    vidSet findHeuristicMIS(algorithm);         // run a heuristic on the graph itself (MDG, VSA or MVSA)
+    cardinal getKernelSize();                   // number of vertices that are neither disabled nor isolated
+    misCheck checkMIS(const vidSet &);          // check that a MIS is independent, and maximal
     bool saveMIS(const vidSet &, const char *); // save the MIS in a file
+    bool saveSnapshot(const vidSet &, const char *); // save the graph and the MIS in a binary snapshot (.misg)
     unsigned long long getNumberOfCalls()       { return this->numberOfCalls; }
+    unsigned long long getNumberOfCuts()        { return this->numberOfCuts; }
+    unsigned long long getNumberOfTableHits()   { return this->numberOfTableHits; }
+    unsigned long long getNumberOfTableMisses() { return this->numberOfTableMisses; }
+    void setTable(std::size_t, cardinal);       // size (in bytes) and threshold of the transposition table
+    void setMatrixThreshold(cardinal);          // largest graph whose adjacency tests use a matrix (see AdjacencyIndex)
+    void setNumberOfThreads(unsigned t)         { this->numberOfThreads = (t > 0) ? t : 1; }
+    void setDeadline(double);                   // stop the exact algorithms after a number of seconds (0: never)
+    void setLocalSearch(unsigned long long, double); // budget of the local search: iterations and seconds (0, 0: none)
+    void setPortfolio(unsigned, double);        // number of threads and of seconds of the portfolio of heuristics
+    unsigned long long getNumberOfRestarts()    { return this->numberOfRestarts; }
+    cardinal getUpperBound();                   // no MIS is larger than this (as proven by the last exact algorithm)
+    bool isOptimal()                            { return !this->stopped || this->openBound <= this->MIS.size(); }
 };
 
 #endif /* Graph_hpp */
@@ -0,0 +1,78 @@
+// Project: Maximum Independent Set (MIS, version 5)
+// Computer Science (2016-2017), 4th semester
+// Author: Guillaume Cocatre-Zilgien
+// Professor: Michel Ventou
+
+#ifndef GraphLoader_hpp
+#define GraphLoader_hpp
+
+#include <cstdint>
+#include <vector>
+#include "Graph.hpp"
+
+const std::size_t MIN_CHUNK_SIZE = 1 << 20;     // parts of a file smaller than this are not given their own thread
+const char SNAPSHOT_MAGIC[4] {'M', 'I', 'S', 'G'};
+const std::uint32_t SNAPSHOT_VERSION = 1;
+
+// Binary snapshot of a graph (.misg, written by Graph::saveSnapshot()): this header, then the offsets of the rows
+// (numberOfVertices + 1 64-bit integers), the rows of neighbors (numberOfEntries vertices), the vertices that have
+// neighbors in the order of their degree buckets (numberOfLinks vertices, see Graph::loadSnapshot()), and the stored
+// MIS (misSize vertices). All the numbers are in the byte order of the machine that wrote the file.
+struct SnapshotHeader
+{
+    char magic[4];                              // SNAPSHOT_MAGIC
+    std::uint32_t version;                      // SNAPSHOT_VERSION
+    std::uint64_t numberOfVertices;
+    std::uint64_t numberOfEntries;              // twice the number of edges
+    std::uint64_t numberOfLinks;
+    std::uint64_t misSize;                      // 0: no MIS was stored
+    std::uint64_t checksum;                     // of everything after the header (see GraphLoader::checksum())
+};
+
+// Reads the edges of a graph file (DIMACS "p edge" or "p col" with "e V W" lines, or a number of vertices followed by
+// "V W" lines; a line that starts with "MIS" ends the graph). The file is mapped in memory, and split into chunks at
+// newline boundaries, that threads parse at the same time with a hand-written scanner; the edges of the chunks are
+// then put together in the order of the file. Graph(const GraphLoader &) builds the rows of neighbors from them.
+// A snapshot (see SnapshotHeader) is recognized by its first bytes: it is checked and kept mapped, without any parsing,
+// and Graph(const GraphLoader &) takes its rows as they are.
+class GraphLoader
+{
+protected:
+    const char *path;
+    const char *mapping;                        // the file, if it is a snapshot (nullptr otherwise)
+    cardinal n;                                 // number of vertices, as given by the first line of the file
+    std::vector<vidPair> edges;                 // edges in the order of the file (vertices numbered from 0)
+    std::size_t bytes;                          // size of the file
+    unsigned threads;                           // number of threads that parsed the file
+    double seconds;                             // time taken to read the file
+    bool opened, valid;                         // could the file be read? were all the vertices in range?
+    const SnapshotHeader *header;               // header of the snapshot (nullptr for a text file)
+    vidSet storedMIS;                           // MIS stored in the snapshot
+    bool parseSnapshot();                       // check the sizes, the checksum and the vertices of a snapshot
+    const char * parseHeader(const char *, const char *); // finds the number of vertices, returns the next line
+    bool parseChunk(const char *, const char *, std::vector<vidPair> &, bool &) const; // false: vertex out of range
+public:
+    GraphLoader(const char *, unsigned threads = 0); // 0: one thread per core
+    GraphLoader(const GraphLoader &) = delete;
+    GraphLoader & operator=(const GraphLoader &) = delete;
+    ~GraphLoader();
+    static std::uint64_t checksum(const char *, std::size_t);
+    const char * getPath() const                { return this->path; }
+    bool isOpen() const                         { return this->opened; }
+    bool isValid() const                        { return this->opened && this->valid; }
+    cardinal getNumberOfVertices() const        { return this->n; }
+    const std::vector<vidPair> & getEdges() const { return this->edges; }
+    std::size_t getBytes() const                { return this->bytes; }
+    unsigned getNumberOfThreads() const         { return this->threads; }
+    double getSeconds() const                   { return this->seconds; }
+    bool isSnapshot() const                     { return this->header != nullptr; }
+    const std::uint64_t * getOffsets() const;   // the arrays of a snapshot, where they are mapped
+    const vid * getAdjacency() const;
+    const vid * getLinks() const;
+    cardinal getNumberOfEntries() const         { return this->header ? this->header->numberOfEntries : 0; }
+    cardinal getNumberOfLinks() const           { return this->header ? this->header->numberOfLinks : 0; }
+    const vidSet & getStoredMIS() const         { return this->storedMIS; }
+    double getRate() const;                     // MB/s
+};
+
+#endif /* GraphLoader_hpp */
@@ -0,0 +1,123 @@
+// Project: Maximum Independent Set (MIS, version 5)
+// Computer Science (2016-2017), 4th semester
+// Author: Guillaume Cocatre-Zilgien
+// Professor: Michel Ventou
+
+#ifndef IndexedHeap_hpp
+#define IndexedHeap_hpp
+
+#include <functional>
+#include <limits>
+#include <vector>
+#include "Vertex.hpp"
+
+const std::size_t NOT_IN_HEAP = std::numeric_limits<std::size_t>::max();
+
+// Binary heap of vertices, each with a key, that knows where every vertex is: the key of a vertex can be changed, and a
+// vertex can be removed, in O(log n). The vertex on top has the first key in the order given by Compare; among vertices
+// with the same key, the one with the smallest id comes first.
+template <typename Key, typename Compare = std::less<Key>>
+class IndexedHeap
+{
+protected:
+    std::vector<vid> heap;                      // vertices, in heap order
+    std::vector<std::size_t> position;          // index of each vertex in the heap (NOT_IN_HEAP if it is not there)
+    std::vector<Key> keys;                      // key of each vertex
+    std::vector<std::size_t> stack;             // scratch stack (see collectTop())
+    Compare compare;
+
+    bool isBefore(vid v, vid w) {
+        if (this->compare(this->keys[v], this->keys[w])) return true;
+        if (this->compare(this->keys[w], this->keys[v])) return false;
+        return v < w;
+    }
+    void place(std::size_t i, vid v)            { this->heap[i] = v; this->position[v] = i; }
+    void siftUp(std::size_t i) {
+        vid v {this->heap[i]};
+        while (i > 0 && this->isBefore(v, this->heap[(i - 1) / 2])) {
+            this->place(i, this->heap[(i - 1) / 2]);
+            i = (i - 1) / 2;
+        }
+        this->place(i, v);
+    }
+    void siftDown(std::size_t i) {
+        vid v {this->heap[i]};
+        std::size_t n {this->heap.size()}, child;
+        while ((child = 2 * i + 1) < n) {
+            if (child + 1 < n && this->isBefore(this->heap[child + 1], this->heap[child])) ++child;
+            if (!this->isBefore(this->heap[child], v)) break;
+            this->place(i, this->heap[child]);
+            i = child;
+        }
+        this->place(i, v);
+    }
+public:
+    void reset(std::size_t n) {
+        this->heap.clear();
+        this->position.assign(n, NOT_IN_HEAP);
+        this->keys.assign(n, Key());
+    }
+    bool isEmpty()                              { return this->heap.empty(); }
+    std::size_t getCapacity()                   { return this->position.size(); }
+    bool contains(vid v)                        { return v < this->position.size() && this->position[v] != NOT_IN_HEAP; }
+    vid top()                                   { return this->heap[0]; }
+    const Key & getKey(vid v)                   { return this->keys[v]; }
+    void push(vid v, const Key &key) {
+        this->keys[v] = key;
+        this->heap.push_back(v);
+        this->siftUp(this->heap.size() - 1);
+    }
+
+    // Rebuilding the heap from scratch costs O(n): every vertex is removed, some are added back in any order with
+    // append(), then heapify() restores the heap order
+    void clear() {
+        for (auto &v : this->heap) this->position[v] = NOT_IN_HEAP;
+        this->heap.clear();
+    }
+    void append(vid v, const Key &key) {
+        this->keys[v] = key;
+        this->position[v] = this->heap.size();
+        this->heap.push_back(v);
+    }
+    void heapify() {
+        for (std::size_t i = this->heap.size() / 2; i-- > 0;) this->siftDown(i);
+    }
+    void update(vid v, const Key &key) {
+        bool earlier {this->compare(key, this->keys[v])};
+        this->keys[v] = key;
+        if (earlier) {
+            this->siftUp(this->position[v]);
+        } else {
+            this->siftDown(this->position[v]);
+        }
+    }
+    void remove(vid v) {
+        std::size_t i {this->position[v]};
+        vid last {this->heap.back()};
+        this->heap.pop_back();
+        this->position[v] = NOT_IN_HEAP;
+        if (last == v) return;
+        this->place(i, last);
+        this->siftUp(i);
+        this->siftDown(this->position[last]);
+    }
+
+    // Add to a list every vertex whose key is the same as the key of the top vertex (in no particular order).
+    // Only those vertices and their children are visited.
+    void collectTop(std::vector<vid> &list) {
+        list.clear();
+        if (this->heap.empty()) return;
+        const Key &first {this->keys[this->heap[0]]};
+        this->stack.assign(1, 0);
+        while (!this->stack.empty()) {
+            std::size_t i {this->stack.back()};
+            this->stack.pop_back();
+            if (i >= this->heap.size() || this->compare(first, this->keys[this->heap[i]])) continue;
+            list.push_back(this->heap[i]);
+            this->stack.push_back(2 * i + 1);
+            this->stack.push_back(2 * i + 2);
+        }
+    }
+};
+
+#endif /* IndexedHeap_hpp */
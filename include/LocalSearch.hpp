@@ -0,0 +1,69 @@
+// Project: Maximum Independent Set (MIS, version 5)
+// Computer Science (2016-2017), 4th semester
+// Author: Guillaume Cocatre-Zilgien
+// Professor: Michel Ventou
+
+#ifndef LocalSearch_hpp
+#define LocalSearch_hpp
+
+#include <random>
+#include <vector>
+#include "Graph.hpp"
+#include "Timer.hpp"
+
+const unsigned SEARCH_CHECK_INTERVAL = 256;     // number of iterations between two readings of the clock
+
+// Iterated local search (Andrade, Resende & Werneck), used to improve the independent set found by the heuristics.
+//
+// The tightness of a vertex is its number of neighbors in the current solution: a vertex is free if it is not part of
+// the solution and its tightness is 0. A (1,2)-swap removes a vertex x from the solution, and inserts two of its
+// neighbors that are not connected to each other, and whose only neighbor in the solution is x (their tightness is 1).
+// Each iteration forces a random vertex (sometimes two) into the solution, removes its neighbors from it, then applies
+// (1,2)-swaps until there are none left. A smaller solution is undone, a solution at least as large is kept.
+//
+// The enabled vertices of the graph are copied into a compact adjacency array, so the graph itself is never modified.
+class LocalSearch
+{
+protected:
+    std::vector<cardinal> offsets;              // neighbors of v: adjacency[offsets[v]] to adjacency[offsets[v + 1] - 1]
+    std::vector<vid> adjacency;                 // neighbors of every vertex, one after the other
+    std::vector<vid> kernel;                    // enabled vertices with at least one neighbor (perturbation targets)
+    std::vector<bool> inSolution;               // is a vertex part of the current solution?
+    std::vector<score> tightness;               // number of neighbors of a vertex in the current solution
+    std::vector<vid> solutionNeighbors;         // XOR of the neighbors of a vertex in the solution (the only one, if 1-tight)
+    std::vector<vid> solution;                  // vertices of the current solution, in no particular order
+    std::vector<vid> freeVertices;              // vertices that could be added to the solution as they are
+    std::vector<cardinal> position;             // index of a vertex in solution or in freeVertices (if any)
+    std::vector<vid> candidates;                // vertices of the solution that may allow a (1,2)-swap
+    std::vector<bool> queued;                   // is a vertex in the list of candidates?
+    std::vector<vid> oneTight;                  // scratch list (see swapVertex())
+    std::vector<unsigned> marks;                // scratch marks, valid when equal to the current stamp
+    unsigned stamp;
+    std::vector<std::pair<vid, bool>> moves;    // vertices inserted (true) or removed (false) during an iteration
+    bool recordMoves;                           // are insertions and removals recorded (so they can be undone)?
+    std::vector<vid> best;                      // largest solution found so far
+    std::mt19937 rng;
+    unsigned long long maxIterations;           // budget: number of iterations (0: no limit, if there is a time limit)
+    double maxSeconds;                          // budget: number of seconds (0: no limit)
+    unsigned long long numberOfIterations;
+
+    bool isOverBudget(Timer &);                 // should the search stop (the clock is not read every time)?
+    void enqueue(vid);                          // add a vertex of the solution to the list of candidates
+    void addFree(vid);
+    void removeFree(vid);
+    void insertVertex(vid);                     // add a vertex to the solution
+    void removeVertex(vid);                     // remove a vertex from the solution
+    void insertFreeVertices();                  // add free vertices until the solution is maximal
+    bool swapVertex(vid);                       // look for a (1,2)-swap around a vertex of the solution, and apply it
+    void descend();                             // apply (1,2)-swaps until there are none left
+    void perturb();                             // force random vertices into the solution
+    void undo();                                // undo every move of the current iteration
+public:
+    LocalSearch(Graph &);
+    void setBudget(unsigned long long, double); // number of iterations, number of seconds (the first one reached)
+    void setSeed(unsigned seed)                 { this->rng.seed(seed); }
+    vidSet improve(const vidSet &);             // the set must be independent, the result is at least as large
+    unsigned long long getNumberOfIterations()  { return this->numberOfIterations; }
+};
+
+#endif /* LocalSearch_hpp */
@@ -0,0 +1,33 @@
+// Project: Maximum Independent Set (MIS, version 5)
+// Computer Science (2016-2017), 4th semester
+// Author: Guillaume Cocatre-Zilgien
+// Professor: Michel Ventou
+
+#ifndef Ordering_hpp
+#define Ordering_hpp
+
+#include <vector>
+#include "Graph.hpp"
+
+// Orders in which the vertices of a graph can be renumbered (see Graph::relabel()), so that neighbors get close IDs:
+// the loops over the neighbors of a vertex then read nearby entries of the arrays indexed by vertex (degrees, supports,
+// marks...), instead of jumping all over them.
+//
+// - Degeneracy: vertices with the smallest degree are removed first, and numbered in that order (Matula & Beck).
+// - Reverse Cuthill-McKee: breadth-first search from a vertex of smallest degree, that visits the neighbors with the
+//   smallest degree first; the order is reversed at the end (it keeps the adjacency matrix close to its diagonal).
+// - BFS: plain breadth-first search, from the first vertex of each connected component.
+class Ordering
+{
+protected:
+    Graph &graph;
+    std::vector<vid> order;                     // vertex of the graph at each position of the order
+    void orderByDegeneracy();
+    void orderByBFS(bool);                      // with true: reverse Cuthill-McKee
+public:
+    Ordering(Graph &, ordering);
+    const std::vector<vid> & getOrder()         { return this->order; }
+    static const char * getName(ordering);
+};
+
+#endif /* Ordering_hpp */
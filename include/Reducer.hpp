@@ -0,0 +1,65 @@
+// Project: Maximum Independent Set (MIS, version 5)
+// Computer Science (2016-2017), 4th semester
+// Author: Guillaume Cocatre-Zilgien
+// Professor: Michel Ventou
+
+#ifndef Reducer_hpp
+#define Reducer_hpp
+
+#include <vector>
+#include "Graph.hpp"
+
+const cardinal MAX_CONFINING_SET = 8;           // largest set that is grown when looking for unconfined vertices
+const score MAX_SEARCH_DEGREE = 8;              // largest degree examined by the domination rule during a search
+
+// Number of times each reduction was applied
+typedef struct {
+    unsigned long long pendant;
+    unsigned long long triangle;
+    unsigned long long twin;
+    unsigned long long dominated;
+    unsigned long long unconfined;
+    unsigned long long folded;
+    unsigned long long LP;
+} reductionCounters;
+
+// Reduction rules find vertices that are known to be (or not to be) part of a MIS, without branching.
+// A vertex that is part of the MIS stays enabled, with a degree of 0; the other vertices are disabled.
+// Only the vertices whose neighborhood changed are examined again (they are kept in a worklist).
+//
+// Structural reductions (degree 2 folding, and the LP reduction, which generalizes crowns) are only allowed outside of
+// the exact algorithm: folding adds edges, which the trail cannot undo. Folds are recorded in the graph, so that a MIS
+// of the reduced graph can be lifted back to the original graph (see Graph::liftMIS()).
+class Reducer
+{
+protected:
+    Graph &graph;
+    bool structural;                            // are degree 2 folding and the LP reduction allowed?
+    std::vector<vid> worklist;                  // vertices whose neighborhood changed
+    std::vector<bool> queued;                   // is a vertex in the worklist?
+    std::vector<unsigned> marks;                // scratch marks, valid when equal to the current stamp
+    unsigned stamp;
+    std::vector<unsigned> counts;               // scratch counters (number of neighbors in a confining set)
+    std::vector<vid> confining, touched;        // scratch sets (confining set, and vertices with a counter)
+    reductionCounters counters;
+    Vertex & getVertex(vid v)                   { return this->graph.vertices[v]; }
+    NeighborRange getNeighbors(vid v)           { return this->graph.getNeighbors(v); }
+    void enqueue(vid);                          // add a vertex to the worklist
+    void newStamp();                            // invalidate all marks
+    void markNeighbors(vid);                    // mark the neighbors of a vertex with a new stamp
+    bool reduceTriangle(vid);                   // degree 2, with connected neighbors
+    bool reduceTwin(vid);                       // degree 2 or 3, with a twin
+    bool reduceFold(vid);                       // degree 2, with disconnected neighbors
+    bool reduceDominated(vid);                  // a neighbor has all the neighbors of this vertex
+    bool reduceUnconfined(vid);                 // this vertex can be removed (Xiao & Nagamochi)
+    bool reduceLP();                            // LP relaxation (Nemhauser & Trotter)
+public:
+    Reducer(Graph &, bool);
+    void excludeVertex(vid);                    // a vertex is NOT part of the MIS
+    void includeVertex(vid);                    // a vertex is part of the MIS
+    void enqueueAll();                          // examine every enabled vertex
+    void reduce();                              // apply the reductions until the worklist is empty
+    const reductionCounters & getCounters()     { return this->counters; }
+};
+
+#endif /* Reducer_hpp */
@@ -0,0 +1,110 @@
+// Project: Maximum Independent Set (MIS, version 5)
+// Computer Science (2016-2017), 4th semester
+// Author: Guillaume Cocatre-Zilgien
+// Professor: Michel Ventou
+
+#ifndef SemiExternal_hpp
+#define SemiExternal_hpp
+
+#include <cstdio>
+#include <vector>
+#include "Graph.hpp"
+
+const std::size_t STREAM_BUFFER_SIZE = 1 << 20; // bytes read from the file at a time
+const unsigned DEFAULT_SWAP_ROUNDS = 10;        // rounds of one-k-swaps of the semi-external mode
+
+// Reads the edges of a graph file one after the other, without keeping them (same formats as Graph(const char *))
+class EdgeStream
+{
+protected:
+    FILE *file;
+    std::vector<char> buffer;
+    std::size_t position, size;                 // next character, and number of characters in the buffer
+    unsigned long long bytesRead;
+    cardinal numberOfVertices;                  // as given by the first line of the file (0 if there is none)
+    bool valid;                                 // were all the vertices of the edges read so far in range?
+    int getChar() {
+        if (this->position == this->size) {
+            this->size = fread(this->buffer.data(), 1, this->buffer.size(), this->file);
+            this->position = 0;
+            this->bytesRead += this->size;
+            if (this->size == 0) return EOF;
+        }
+        return (unsigned char) this->buffer[this->position++];
+    }
+    bool readLine(char &, unsigned long *, unsigned &); // first letter and first two numbers of the next line
+public:
+    EdgeStream(const char *);                   // opens the file and reads its first line
+    ~EdgeStream();
+    bool isOpen()                               { return this->file != nullptr; }
+    bool isValid()                              { return this->valid; }
+    cardinal getNumberOfVertices()              { return this->numberOfVertices; }
+    unsigned long long getBytesRead()           { return this->bytesRead; }
+    bool next(vid &, vid &);                    // next edge (vertices numbered from 0), false at the end of the file
+};
+
+/**
+ *  Semi-external heuristic, for graphs whose edges do not fit in memory: only a few bytes per vertex are kept, and the
+ *  edges are read from the file again at each pass, in the order of the file (Liu, Lu, Yang, Xiao and Wei, "Towards
+ *  Maximum Independent Sets on Massive Graphs"). The vertices are ranked by degree; a first pass keeps, of the two
+ *  vertices of each edge, the one with the smallest degree, then vertices with no neighbor in the set are added, and
+ *  one-k-swaps replace a vertex of the set with at least two of its neighbors, that have no other neighbor in it.
+ */
+class SemiExternal
+{
+protected:
+    enum vertexState : unsigned char {
+        STATE_IN,                               // in the set
+        STATE_OUT,                              // not in the set
+        STATE_CANDIDATE,                        // not in the set, may be added to it
+        STATE_LEAVING,                          // in the set, swapped for its candidates at the end of the pass
+        STATE_REVERTED                          // in the set, whose swap was undone
+    };
+    const char *path;
+    cardinal n;                                 // number of vertices
+    std::vector<score> degrees;
+    std::vector<vid> ranks;                     // position of each vertex, by degree (the smallest degrees first)
+    std::vector<vertexState> states;
+    std::vector<unsigned char> counts;          // scratch counters, up to 2 (neighbors in the set, candidates...)
+    std::vector<vid> owners;                    // vertex of the set that is the only neighbor of a candidate
+    cardinal size;                              // cardinality of the set
+    cardinal greedySize;                        // cardinality of the set before the one-k-swaps
+    unsigned rounds;                            // number of rounds of one-k-swaps that improved the set
+    unsigned passes;                            // number of times the file was read
+    unsigned long long bytesRead;               // number of bytes read, over every pass
+    bool valid;                                 // was every pass able to read the file entirely?
+    template <typename Function>
+    void streamEdges(Function);                 // read every edge of the file (but self-loops) once
+    vid getLastRank(vid v, vid w)               { return (this->ranks[v] > this->ranks[w]) ? v : w; }
+    void rankVertices();
+    void findGreedySet();                       // first pass: drop the vertex of largest degree of every edge
+    cardinal completeSet();                     // add the vertices that have no neighbor in the set
+    cardinal swapVertices();                    // one round of one-k-swaps
+public:
+    SemiExternal(const char *);                 // reads the number of vertices and their degrees (first pass)
+    bool isValid()                              { return this->valid; }
+    cardinal getNumberOfVertices()              { return this->n; }
+    cardinal findMIS(unsigned);                 // greedy, then up to a number of rounds of one-k-swaps
+    bool checkMIS();                            // check that no edge has both of its vertices in the set (one pass)
+    bool saveMIS(const char *);                 // same format as Graph::saveMIS() (one pass)
+    cardinal getGreedySize()                    { return this->greedySize; }
+    unsigned getNumberOfRounds()                { return this->rounds; }
+    unsigned getNumberOfPasses()                { return this->passes; }
+    unsigned long long getBytesRead()           { return this->bytesRead; }
+    static double getPeakMemory();              // peak resident set size of the process, in MB
+};
+
+template <typename Function>
+void SemiExternal::streamEdges(Function f)
+{
+    EdgeStream edges(this->path);
+    vid v, w;
+    while (edges.next(v, w)) {
+        if (v != w) f(v, w);
+    }
+    ++this->passes;
+    this->bytesRead += edges.getBytesRead();
+    if (!edges.isOpen() || !edges.isValid() || edges.getNumberOfVertices() != this->n) this->valid = false;
+}
+
+#endif /* SemiExternal_hpp */
@@ -0,0 +1,47 @@
+// Project: Maximum Independent Set (MIS, version 5)
+// Computer Science (2016-2017), 4th semester
+// Author: Guillaume Cocatre-Zilgien
+// Professor: Michel Ventou
+
+#ifndef Simd_hpp
+#define Simd_hpp
+
+#include <cstddef>
+
+// Vectorized kernels for the loops over lists of neighbors. The AVX2 versions are compiled with a target attribute
+// (the rest of the program does not need -mavx2), and chosen at runtime if the processor supports them; otherwise,
+// or if the program is built with -DNO_SIMD, the scalar versions are used.
+// Vertices and scores are both unsigned integers (vid and score, see Vertex.hpp, which includes this file).
+
+const std::size_t SIMD_MIN_SIZE = 16;           // shorter lists are always handled by the scalar loops
+
+namespace simd
+{
+    std::size_t findVertexKernel(const unsigned *, std::size_t, unsigned);
+    unsigned sumScoresKernel(const unsigned *, std::size_t, const unsigned *);
+
+    // Index of a vertex in a list (the size of the list if it is not there)
+    inline std::size_t findVertex(const unsigned *list, std::size_t size, unsigned v)
+    {
+        if (size >= SIMD_MIN_SIZE) return findVertexKernel(list, size, v);
+        for (std::size_t i = 0; i < size; ++i) {
+            if (list[i] == v) return i;
+        }
+        return size;
+    }
+
+    // Sum of scores[list[i]] over a list of vertices (the largest vertex must fit in 31 bits)
+    inline unsigned sumScores(const unsigned *list, std::size_t size, const unsigned *scores)
+    {
+        if (size >= SIMD_MIN_SIZE) return sumScoresKernel(list, size, scores);
+        unsigned sum {0};
+        for (std::size_t i = 0; i < size; ++i) {
+            sum += scores[list[i]];
+        }
+        return sum;
+    }
+
+    bool isVectorized();                        // are the AVX2 kernels used?
+}
+
+#endif /* Simd_hpp */
@@ -0,0 +1,212 @@
+// Project: Maximum Independent Set (MIS, version 5)
+// Computer Science (2016-2017), 4th semester
+// Author: Guillaume Cocatre-Zilgien
+// Professor: Michel Ventou
+
+#ifndef SmallMIS_hpp
+#define SmallMIS_hpp
+
+#include <cstring>
+#include "BitGraph.hpp"
+#include "Timer.hpp"
+
+// Exact algorithm for graphs of at most Words * 64 vertices, used to finish the search once few vertices remain
+// (see Graph::findSmallMIS()). Everything is a fixed-width bitset: the number of words is known at compile time, so
+// every loop over the words of a bitset is unrolled by the compiler, and nothing is ever allocated (the adjacency matrix
+// is part of the object, and each recursive call keeps its bitsets on the stack).
+template <unsigned Words>
+class SmallMIS
+{
+public:
+    static const cardinal CAPACITY = Words * WORD_BITS;
+protected:
+    word adjacency[CAPACITY][Words];            // adjacency matrix, one bitset per vertex
+    word best[Words];                           // largest independent set found so far
+    cardinal size;                              // number of vertices
+    cardinal bestSize;                          // cardinality of the largest independent set found so far
+    bool found;                                 // was an independent set larger than the target found?
+    unsigned long long numberOfCalls;
+    unsigned long long numberOfCuts;            // number of branches cut by the clique cover
+    bool hasDeadline;                           // should the search stop at some point?
+    timePoint deadline;                         // point in time at which the search stops
+    unsigned deadlineCountdown;                 // number of calls until the clock is read again
+    bool stopped;                               // did the search stop before the end?
+    cardinal openBound;                         // largest upper bound of the abandoned branches
+
+    static bool isEmpty(const word *set) {
+        word bits {0};
+        for (unsigned i = 0; i < Words; ++i) bits |= set[i];
+        return bits == 0;
+    }
+    static cardinal count(const word *set) {
+        cardinal c {0};
+        for (unsigned i = 0; i < Words; ++i) c += (cardinal) __builtin_popcountll(set[i]);
+        return c;
+    }
+    static vid first(const word *set) {
+        for (unsigned i = 0; i < Words; ++i) {
+            if (set[i] != 0) return (vid) (i * WORD_BITS + __builtin_ctzll(set[i]));
+        }
+        return NO_VERTEX_FOUND;
+    }
+    static void remove(word *set, vid v)        { set[v / WORD_BITS] &= ~((word) 1 << (v % WORD_BITS)); }
+    static void insert(word *set, vid v)        { set[v / WORD_BITS] |= (word) 1 << (v % WORD_BITS); }
+    score getDegree(vid v, const word *set) {
+        score degree {0};
+        for (unsigned i = 0; i < Words; ++i) degree += (score) __builtin_popcountll(this->adjacency[v][i] & set[i]);
+        return degree;
+    }
+
+    // Greedy clique cover of a set of vertices, that stops as soon as it has more than a given number of cliques
+    cardinal countCliques(const word *set, cardinal limit) {
+        word remaining[Words], candidates[Words];
+        cardinal cliques {0};
+        memcpy(remaining, set, sizeof(remaining));
+        while (!isEmpty(remaining) && cliques <= limit) {
+            vid v {first(remaining)};
+            remove(remaining, v);
+            for (unsigned i = 0; i < Words; ++i) candidates[i] = remaining[i] & this->adjacency[v][i];
+            while (!isEmpty(candidates)) {
+                vid u {first(candidates)};
+                remove(remaining, u);
+                for (unsigned i = 0; i < Words; ++i) candidates[i] &= this->adjacency[u][i];
+            }
+            ++cliques;
+        }
+        return cliques;
+    }
+
+    /**
+     *  Same algorithm as BitGraph::search(): vertices with a degree of 0 or 1 are selected right away, then we branch on
+     *  the vertex with the highest degree (without it, then with it). A branch is cut if a greedy clique cover of its
+     *  remaining vertices shows that it cannot beat the largest independent set found so far.
+     */
+    void search(const word *set, const word *selected, cardinal selectedCount) {
+        ++this->numberOfCalls;
+        word remaining[Words], chosen[Words];
+        memcpy(remaining, set, sizeof(remaining));
+        memcpy(chosen, selected, sizeof(chosen));
+
+        if (this->hasDeadline && this->deadlineCountdown-- == 0) {
+            this->deadlineCountdown = DEADLINE_CHECK_INTERVAL;
+            this->stopped = (Time::now() >= this->deadline);
+        }
+        if (this->stopped) {
+            cardinal bound {selectedCount + count(remaining)};
+            if (bound > this->openBound) this->openBound = bound;
+            return;
+        }
+
+        vid candidate {NO_VERTEX_FOUND};
+        score degree, maxDegree {0};
+        cardinal left {0};
+        bool reduced {true};
+        while (reduced) {
+            reduced = false;
+            candidate = NO_VERTEX_FOUND;
+            maxDegree = 0;
+            left = 0;
+            for (unsigned i = 0; i < Words && !reduced; ++i) {
+                word bits {remaining[i]};
+                while (bits != 0) {
+                    vid v {(vid) (i * WORD_BITS + __builtin_ctzll(bits))};
+                    bits &= bits - 1;
+                    degree = this->getDegree(v, remaining);
+                    if (degree <= 1) {
+                        if (degree == 1) { // remove its only neighbor, then start over (degrees have changed)
+                            for (unsigned j = 0; j < Words; ++j) remaining[j] &= ~this->adjacency[v][j];
+                            reduced = true;
+                        }
+                        remove(remaining, v);
+                        insert(chosen, v);
+                        ++selectedCount;
+                        if (reduced) break;
+                    } else {
+                        ++left;
+                        if (degree > maxDegree) {
+                            candidate = v;
+                            maxDegree = degree;
+                        }
+                    }
+                }
+            }
+        }
+
+        if (left == 0) { // terminal condition
+            if (selectedCount > this->bestSize) {
+                memcpy(this->best, chosen, sizeof(this->best));
+                this->bestSize = selectedCount;
+                this->found = true;
+            }
+            return;
+        }
+        cardinal limit {(this->bestSize > selectedCount) ? this->bestSize - selectedCount : 0};
+        if (selectedCount + left <= this->bestSize) {
+            return;
+        }
+        if (selectedCount + this->countCliques(remaining, limit) <= this->bestSize) {
+            ++this->numberOfCuts;
+            return;
+        }
+
+        // Disable the vertex with the highest degree
+        word next[Words];
+        memcpy(next, remaining, sizeof(next));
+        remove(next, candidate);
+        this->search(next, chosen, selectedCount);
+
+        // Keep the vertex with the highest degree (disable its neighbors)
+        if (selectedCount + left - maxDegree > this->bestSize) {
+            for (unsigned i = 0; i < Words; ++i) next[i] = remaining[i] & ~this->adjacency[candidate][i];
+            remove(next, candidate);
+            insert(chosen, candidate);
+            this->search(next, chosen, selectedCount + 1);
+        }
+    }
+public:
+    SmallMIS(cardinal n) : size {n}, bestSize {0}, found {false}, numberOfCalls {0}, numberOfCuts {0},
+                           hasDeadline {false}, deadlineCountdown {0}, stopped {false}, openBound {0} {
+        memset(this->adjacency, 0, n * sizeof(this->adjacency[0]));
+        memset(this->best, 0, sizeof(this->best));
+    }
+    void addNeighbor(vid v, vid w)              { insert(this->adjacency[v], w); }
+    void setDeadline(timePoint d)               { this->hasDeadline = true; this->deadline = d; }
+    bool isSelected(vid v)                      { return (this->best[v / WORD_BITS] >> (v % WORD_BITS)) & 1; }
+    bool isStopped()                            { return this->stopped; }
+    cardinal getUpperBound() {
+        return (this->openBound > this->bestSize) ? this->openBound : this->bestSize;
+    }
+    unsigned long long getNumberOfCalls()       { return this->numberOfCalls; }
+
+    // Is a set (of a given number of words) made of vertices of the graph, independent, and of a given cardinality?
+    bool isIndependentSet(const word *set, unsigned words, cardinal cardinality) {
+        cardinal c {0};
+        for (unsigned i = 0; i < words; ++i) {
+            word bits {set[i]};
+            c += (cardinal) __builtin_popcountll(bits);
+            while (bits != 0) {
+                vid v {(vid) (i * WORD_BITS + __builtin_ctzll(bits))};
+                bits &= bits - 1;
+                if (v >= this->size) return false;
+                for (unsigned j = 0; j < Words && j < words; ++j) {
+                    if ((this->adjacency[v][j] & set[j]) != 0) return false;
+                }
+            }
+        }
+        return c == cardinality;
+    }
+    unsigned long long getNumberOfCuts()        { return this->numberOfCuts; }
+
+    // Look for an independent set with more than a given number of vertices (see isSelected())
+    bool solve(cardinal target) {
+        word set[Words], selected[Words];
+        memset(set, 0, sizeof(set));
+        memset(selected, 0, sizeof(selected));
+        for (vid v = 0; v < this->size; ++v) insert(set, v);
+        this->bestSize = target;
+        this->search(set, selected, 0);
+        return this->found;
+    }
+};
+
+#endif /* SmallMIS_hpp */
@@ -0,0 +1,73 @@
+// Project: Maximum Independent Set (MIS, version 5)
+// Computer Science (2016-2017), 4th semester
+// Author: Guillaume Cocatre-Zilgien
+// Professor: Michel Ventou
+
+#ifndef TranspositionTable_hpp
+#define TranspositionTable_hpp
+
+#include <cstdint>
+#include <mutex>
+#include <vector>
+#include "BitGraph.hpp"
+
+typedef std::uint64_t hashKey;
+
+const unsigned TABLE_WAYS = 4;                  // number of entries in a set of the table
+const unsigned TABLE_WORDS = 2;                 // words of the set of vertices kept in an entry
+const cardinal MAX_TABLE_THRESHOLD = TABLE_WORDS * WORD_BITS; // largest subgraph that can be stored in the table
+
+// Hash of an edge between two vertices of a subgraph (splitmix64); a subgraph is hashed by adding up the hashes of its
+// edges, with a XOR (the key) and with a sum (the check), starting from the hash of its number of vertices
+inline hashKey hashEdge(vid v, vid w)
+{
+    hashKey z {(((hashKey) v << 32) | w) + 0x9E3779B97F4A7C15ULL};
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+// What is known of the MIS of a subgraph: either a MIS itself (exact), or only an upper bound of its cardinality
+typedef struct {
+    cardinal bound;                             // cardinality of the MIS (exact), or no MIS is larger than this
+    bool exact;                                 // is selected a MIS of the subgraph?
+    word selected[TABLE_WORDS];                 // vertices of the MIS, numbered as in the subgraph (exact only)
+} tableResult;
+
+// Cache of the small subgraphs solved by the exact algorithm (see Graph::findSmallMIS()). A subgraph is identified by
+// its edges between vertices numbered from 0, in the order of the graph: once the search has split the graph into
+// components, the same small components come back in most branches, and they have the same MIS every time, whichever
+// vertices they are made of.
+//
+// The table is set-associative: a key can only go in one set of TABLE_WAYS entries. When a set is full, an entry that
+// was not read since the clock hand last went over it is replaced (second chance). The components of a graph may be
+// solved in several threads, so every access is locked.
+class TranspositionTable
+{
+protected:
+    struct Entry
+    {
+        hashKey key;                            // hash of a subgraph
+        std::uint32_t check;                    // second hash of the same subgraph (tells apart two with the same key)
+        std::uint16_t bound;                    // see tableResult
+        std::uint8_t flags;                     // USED, EXACT and REFERENCED
+        word selected[TABLE_WORDS];             // see tableResult
+    };
+    static const std::uint8_t USED = 1;         // the entry holds a subgraph
+    static const std::uint8_t EXACT = 2;        // the entry holds a MIS, not only a bound
+    static const std::uint8_t REFERENCED = 4;   // the entry was read since the clock hand last went over it
+    std::vector<Entry> entries;                 // sets of TABLE_WAYS entries (allocated by the first store)
+    std::vector<std::uint8_t> hands;            // clock hand of each set
+    std::size_t numberOfSets;                   // a power of 2 (0: no table)
+    hashKey mask;                               // number of sets - 1
+    unsigned long long numberOfEvictions;       // number of entries that were replaced
+    std::mutex lock;
+public:
+    TranspositionTable(std::size_t);            // the size is given in bytes (0: no table)
+    bool isEnabled()                            { return this->numberOfSets > 0; }
+    bool lookup(hashKey, hashKey, tableResult &); // get what is known of a subgraph, if anything
+    void store(hashKey, hashKey, const tableResult &); // keep what was learned about a subgraph
+    unsigned long long getNumberOfEvictions()   { return this->numberOfEvictions; }
+};
+
+#endif /* TranspositionTable_hpp */
@@ -7,73 +7,168 @@
 #define Vertex_hpp
 
 #include <algorithm>
+#include <cstdint>
 #include <forward_list>
 #include <limits>
 #include <set>
-#include <stdexcept>
 #include <vector>
+#include "Simd.hpp"
 
 typedef unsigned vid;
 typedef unsigned score;
 
 // Generic class for selecting whichever implementation we want to use;
 // it enabled me to test the performance of 3 different implementations.
-template <typename vidList>
+// There is no virtual method: each implementation only says how its neighbors are stored (insert(), erase(),
+// contains(), forEach()), and is passed to GenericVertex as a template parameter (curiously recurring template
+// pattern), so every call is resolved at compile time and can be inlined, and vertices carry no pointer to a vtable.
+// (They were replaced by CSRVertex, see below, but they can still be compared with it: see BasicGraph.)
+template <typename Storage, typename vidList>
 class GenericVertex
 {
-    friend class Graph;
+    template <typename> friend class BasicGraph;
 protected:
     vid id;
     score degree;
     vidList neighbors;
     bool enabled;
+    vid previous, next;                     // other vertices with the same degree (see BasicGraph::linkVertex())
+    Storage & storage()                     { return static_cast<Storage &>(*this); }
     void disable()                          { enabled = false; neighbors.clear(); degree = 0; }
     void clearNeighbors()                   { neighbors.clear(); degree = 0; }
-    virtual void addNeighbor(vid) = 0;
-    virtual void removeNeighbor(vid) = 0;
+    void addNeighbor(vid v)                 { storage().insert(v); ++degree; }
+    void removeNeighbor(vid v)              { storage().erase(v); --degree; }
 public:
     GenericVertex()                         : id {0}, degree {0}, enabled {true} {}
     GenericVertex(vid n)                    : id {n}, degree {0}, enabled {true} {}
-    vid operator[](int i) {
-        if (i < degree) {
-            auto it = neighbors.cbegin() + i; return *it;
-        } else {
-            throw std::out_of_range("No such neighbor");
-        }
-    }
     vid getID()                             { return id; }
     void setID(vid id)                      { this->id = id; }
     score getDegree()                       { return degree; }
     bool isEnabled()                        { return enabled; }
-    bool isIsolated()                       { return neighbors.empty(); }
-    bool isConnectedTo(vid v)               { return find(neighbors.cbegin(), neighbors.cend(), v) != neighbors.cend(); }
+    bool isIsolated()                       { return degree == 0; }
+    bool isConnectedTo(vid v)               { return storage().contains(v); }
+    template <typename Function>
+    void forEachNeighbor(Function f)        { storage().forEach(f); }
 };
 
 // Vertex class that uses a list of neighbors (turned out to be too slow)
-class ListVertex : public GenericVertex<std::forward_list<vid>>
+class ListVertex : public GenericVertex<ListVertex, std::forward_list<vid>>
 {
-    friend class Graph;
+    friend class GenericVertex<ListVertex, std::forward_list<vid>>;
 protected:
-    void addNeighbor(vid v)                 { neighbors.push_front(v); ++degree; }
-    void removeNeighbor(vid v)              { neighbors.remove(v); --degree; }
+    void insert(vid v)                      { neighbors.push_front(v); }
+    void erase(vid v)                       { neighbors.remove(v); }
+    bool contains(vid v) {
+        return std::find(neighbors.cbegin(), neighbors.cend(), v) != neighbors.cend();
+    }
+    template <typename Function>
+    void forEach(Function f)                { for (vid w : neighbors) f(w); }
 };
 
 // Vertex class using a vector of neighbors (turned out to be the fastest)
-class VectorVertex : public GenericVertex<std::vector<vid>>
+class VectorVertex : public GenericVertex<VectorVertex, std::vector<vid>>
 {
-    friend class Graph;
+    friend class GenericVertex<VectorVertex, std::vector<vid>>;
+protected:
+    void insert(vid v)                      { neighbors.push_back(v); }
+    void erase(vid v) {
+        neighbors.erase(neighbors.cbegin() + simd::findVertex(neighbors.data(), neighbors.size(), v));
+    }
+    bool contains(vid v)                    { return simd::findVertex(neighbors.data(), degree, v) < degree; }
+    template <typename Function>
+    void forEach(Function f)                { for (vid w : neighbors) f(w); }
+};
+
+// Vertex class using a vector of neighbors sorted by ID: adjacency tests are binary searches, but every insertion and
+// every removal moves the end of the vector
+class SortedVectorVertex : public GenericVertex<SortedVectorVertex, std::vector<vid>>
+{
+    friend class GenericVertex<SortedVectorVertex, std::vector<vid>>;
 protected:
-    void addNeighbor(vid v)                 { neighbors.push_back(v); ++degree; }
-    void removeNeighbor(vid v)              { neighbors.erase(find(neighbors.cbegin(), neighbors.cend(), v)); --degree; }
+    void insert(vid v) {
+        neighbors.insert(std::lower_bound(neighbors.begin(), neighbors.end(), v), v);
+    }
+    void erase(vid v) {
+        neighbors.erase(std::lower_bound(neighbors.begin(), neighbors.end(), v));
+    }
+    bool contains(vid v)                    { return std::binary_search(neighbors.cbegin(), neighbors.cend(), v); }
+    template <typename Function>
+    void forEach(Function f)                { for (vid w : neighbors) f(w); }
 };
 
 // Vertex class using a set of neighbors (turned out to be too slow)
-class SetVertex : public GenericVertex<std::set<vid>>
+class SetVertex : public GenericVertex<SetVertex, std::set<vid>>
+{
+    friend class GenericVertex<SetVertex, std::set<vid>>;
+protected:
+    void insert(vid v)                      { neighbors.insert(v); }
+    void erase(vid v)                       { neighbors.erase(v); }
+    bool contains(vid v)                    { return neighbors.count(v) > 0; }
+    template <typename Function>
+    void forEach(Function f)                { for (vid w : neighbors) f(w); }
+};
+
+// Vertex class using a row of bits, one per vertex of the graph (the row grows up to its largest neighbor): adjacency
+// tests are a single bit, but looking at the neighbors means looking at every word of the row
+class BitsetVertex : public GenericVertex<BitsetVertex, std::vector<std::uint64_t>>
+{
+    friend class GenericVertex<BitsetVertex, std::vector<std::uint64_t>>;
+protected:
+    void insert(vid v) {
+        if (v / 64 >= neighbors.size()) neighbors.resize(v / 64 + 1, 0);
+        neighbors[v / 64] |= (std::uint64_t) 1 << (v % 64);
+    }
+    void erase(vid v)                       { neighbors[v / 64] &= ~((std::uint64_t) 1 << (v % 64)); }
+    bool contains(vid v)                    { return v / 64 < neighbors.size() && (neighbors[v / 64] >> (v % 64)) & 1; }
+    template <typename Function>
+    void forEach(Function f) {
+        for (std::size_t i = 0; i < neighbors.size(); ++i) {
+            for (std::uint64_t bits = neighbors[i]; bits != 0; bits &= bits - 1) {
+                f((vid) (i * 64 + __builtin_ctzll(bits)));
+            }
+        }
+    }
+};
+
+// Vertex class whose neighbors are a row of one array that belongs to the graph (compressed sparse row): no vertex
+// owns any memory, and copying a graph copies a few arrays. The first entries of the row (as many as the degree) are
+// the neighbors of the vertex; the neighbors that were removed are kept after them, most recent first, so that they
+// can be put back in O(1) (see Graph::removeNeighbor() and Graph::restoreNeighbor()).
+class CSRVertex
 {
     friend class Graph;
+    friend class Reducer;
+    friend class LocalSearch;
+protected:
+    vid id;
+    score degree;                           // number of neighbors (the live part of the row)
+    score capacity;                         // number of entries of the row
+    std::size_t offset;                     // first entry of the row, in the adjacency array of the graph
+    bool enabled;
+    vid previous, next;                     // other vertices with the same degree (see Graph::getMaxDegreeVertex())
+    void disable()                          { enabled = false; degree = 0; }
+    void clearNeighbors()                   { degree = 0; }
+public:
+    CSRVertex()                             : id {0}, degree {0}, capacity {0}, offset {0}, enabled {true} {}
+    CSRVertex(vid n)                        : id {n}, degree {0}, capacity {0}, offset {0}, enabled {true} {}
+    vid getID()                             { return id; }
+    void setID(vid id)                      { this->id = id; }
+    score getDegree()                       { return degree; }
+    bool isEnabled()                        { return enabled; }
+    bool isIsolated()                       { return degree == 0; }
+};
+
+// Neighbors of a CSR vertex (see Graph::getNeighbors()), valid until an edge is added to the graph
+class NeighborRange
+{
 protected:
-    void addNeighbor(vid v)                 { neighbors.insert(v); ++degree; }
-    void removeNeighbor(vid v)              { neighbors.erase(v); --degree; }
+    const vid *first, *last;
+public:
+    NeighborRange(const vid *f, const vid *l) : first {f}, last {l} {}
+    const vid * begin() const               { return first; }
+    const vid * end() const                 { return last; }
+    std::size_t size() const                { return last - first; }
+    bool empty() const                      { return first == last; }
 };
 
 #endif /* Vertex_hpp */
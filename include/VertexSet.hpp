@@ -0,0 +1,98 @@
+// Project: Maximum Independent Set (MIS, version 5)
+// Computer Science (2016-2017), 4th semester
+// Author: Guillaume Cocatre-Zilgien
+// Professor: Michel Ventou
+
+#ifndef VertexSet_hpp
+#define VertexSet_hpp
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+#include "Vertex.hpp"
+
+// Set of vertices kept as a bitmap, one bit per vertex (up to the largest vertex inserted so far): inserting a vertex
+// or looking it up is a single bit, copying a set copies one array, and nothing is allocated per vertex. The vertices
+// are listed in increasing order, one word at a time. It only has the part of std::set<vid> that the program uses.
+class VertexSet
+{
+public:
+    typedef std::uint64_t word;
+
+    // Iterable view of the set: skips the empty words, and the bits that are not set in the others
+    class const_iterator
+    {
+        friend class VertexSet;
+    protected:
+        const word *words;
+        std::size_t index, last;                // current word, and number of words
+        word bits;                              // bits of the current word that were not listed yet
+        const_iterator(const word *w, std::size_t i, std::size_t l) : words {w}, index {i}, last {l}, bits {0} {
+            if (this->index < this->last) this->bits = this->words[this->index];
+            this->skipEmptyWords();
+        }
+        void skipEmptyWords() {
+            while (this->bits == 0 && this->index < this->last) {
+                if (++this->index < this->last) this->bits = this->words[this->index];
+            }
+        }
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef vid value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const vid * pointer;
+        typedef vid reference;
+        vid operator*() const                   { return (vid) (this->index * 64 + __builtin_ctzll(this->bits)); }
+        const_iterator & operator++() {
+            this->bits &= this->bits - 1;
+            this->skipEmptyWords();
+            return *this;
+        }
+        const_iterator operator++(int)          { const_iterator it(*this); ++(*this); return it; }
+        bool operator==(const const_iterator &it) const { return this->index == it.index && this->bits == it.bits; }
+        bool operator!=(const const_iterator &it) const { return !(*this == it); }
+    };
+    typedef const_iterator iterator;
+
+protected:
+    std::vector<word> words;
+    std::size_t cardinality;                    // number of vertices in the set
+public:
+    VertexSet()                                 : cardinality {0} {}
+    template <typename InputIterator>
+    VertexSet(InputIterator first, InputIterator last) : cardinality {0} {
+        for (; first != last; ++first) this->insert(*first);
+    }
+    void reserve(std::size_t n) {               // make room for vertices 0 to n - 1
+        if ((n + 63) / 64 > this->words.size()) this->words.resize((n + 63) / 64, 0);
+    }
+    void insert(vid v) {
+        this->reserve((std::size_t) v + 1);
+        word &w {this->words[v / 64]};
+        word bit {(word) 1 << (v % 64)};
+        if ((w & bit) == 0) {
+            w |= bit;
+            ++this->cardinality;
+        }
+    }
+    void erase(vid v) {
+        if (this->count(v) == 0) return;
+        this->words[v / 64] &= ~((word) 1 << (v % 64));
+        --this->cardinality;
+    }
+    std::size_t count(vid v) const {
+        return (v / 64 < this->words.size()) ? (this->words[v / 64] >> (v % 64)) & 1 : 0;
+    }
+    std::size_t size() const                    { return this->cardinality; }
+    bool empty() const                          { return this->cardinality == 0; }
+    void clear() {                              // keeps the memory of the bitmap
+        std::fill(this->words.begin(), this->words.end(), 0);
+        this->cardinality = 0;
+    }
+    const_iterator begin() const                { return const_iterator(words.data(), 0, words.size()); }
+    const_iterator end() const                  { return const_iterator(words.data(), words.size(), words.size()); }
+};
+
+#endif /* VertexSet_hpp */
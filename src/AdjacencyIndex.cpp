@@ -0,0 +1,118 @@
+// Project: Maximum Independent Set (MIS, version 5)
+// Computer Science (2016-2017), 4th semester
+// Author: Guillaume Cocatre-Zilgien
+// Professor: Michel Ventou
+
+#include <algorithm>
+#include "AdjacencyIndex.hpp"
+
+using namespace std;
+
+const AdjacencyIndex::word EMPTY_SLOT = ~0ULL;
+const AdjacencyIndex::word ERASED_SLOT = ~0ULL - 1; // tombstone: the search for an edge goes on after it
+const size_t MIN_SLOTS = 16;
+
+AdjacencyIndex::AdjacencyIndex(size_t n, size_t edges, size_t threshold) : matrix {n <= threshold},
+                                                                            threshold {threshold}, rows {n}, words {0},
+                                                                            used {0}, mask {0}
+{
+    if (this->matrix) {
+        this->words = (n + 63) / 64;
+        this->bits.assign(n * this->words, 0);
+    } else {
+        this->resize(edges);
+    }
+}
+
+// Tombstones are dropped; the table doubles if more than a quarter of it is made of edges
+void AdjacencyIndex::resize(size_t edges)
+{
+    size_t size {MIN_SLOTS};
+    while (size < 4 * edges) size *= 2;
+    vector<word> previous(size, EMPTY_SLOT);
+    previous.swap(this->slots);
+    this->mask = size - 1;
+    this->used = 0;
+    for (auto &key : previous) {
+        if (key == EMPTY_SLOT || key == ERASED_SLOT) continue;
+        size_t i {this->getSlot(key)};
+        while (this->slots[i] != EMPTY_SLOT) i = (i + 1) & this->mask;
+        this->slots[i] = key;
+        ++this->used;
+    }
+}
+
+/**
+ *  A hash set of edges does not depend on the number of vertices. A matrix doubles its number of rows (up to the
+ *  threshold) when it runs out of them, so that adding vertices one at a time only copies it a few times.
+ */
+bool AdjacencyIndex::grow(size_t n)
+{
+    if (!this->matrix || n <= this->rows) return true;
+    if (n > this->threshold) return false;
+    size_t capacity {min(max(2 * this->rows, n), this->threshold)}, width {(capacity + 63) / 64};
+    vector<word> previous(capacity * width, 0);
+    previous.swap(this->bits);
+    for (size_t v = 0; v < this->rows; ++v) {
+        copy_n(previous.begin() + v * this->words, this->words, this->bits.begin() + v * width);
+    }
+    this->rows = capacity;
+    this->words = width;
+    return true;
+}
+
+void AdjacencyIndex::insert(vid v, vid w)
+{
+    if (this->matrix) {
+        this->bits[v * this->words + w / 64] |= (word) 1 << (w % 64);
+        this->bits[w * this->words + v / 64] |= (word) 1 << (v % 64);
+        return;
+    }
+    if (2 * (this->used + 1) > this->slots.size()) {
+        size_t edges {0};
+        for (auto &key : this->slots) {
+            if (key != EMPTY_SLOT && key != ERASED_SLOT) ++edges;
+        }
+        this->resize(edges + 1);
+    }
+    word key {getKey(v, w)};
+    size_t i {this->getSlot(key)}, erased {this->slots.size()};
+    for (; this->slots[i] != EMPTY_SLOT; i = (i + 1) & this->mask) {
+        if (this->slots[i] == key) return;
+        if (this->slots[i] == ERASED_SLOT && erased == this->slots.size()) erased = i;
+    }
+    if (erased != this->slots.size()) {
+        this->slots[erased] = key;
+    } else {
+        this->slots[i] = key;
+        ++this->used;
+    }
+}
+
+void AdjacencyIndex::erase(vid v, vid w)
+{
+    if (this->matrix) {
+        this->bits[v * this->words + w / 64] &= ~((word) 1 << (w % 64));
+        this->bits[w * this->words + v / 64] &= ~((word) 1 << (v % 64));
+        return;
+    }
+    word key {getKey(v, w)};
+    for (size_t i = this->getSlot(key); this->slots[i] != EMPTY_SLOT; i = (i + 1) & this->mask) {
+        if (this->slots[i] == key) {
+            this->slots[i] = ERASED_SLOT;
+            return;
+        }
+    }
+}
+
+bool AdjacencyIndex::contains(vid v, vid w) const
+{
+    if (this->matrix) {
+        return (this->bits[v * this->words + w / 64] >> (w % 64)) & 1;
+    }
+    word key {getKey(v, w)};
+    for (size_t i = this->getSlot(key); this->slots[i] != EMPTY_SLOT; i = (i + 1) & this->mask) {
+        if (this->slots[i] == key) return true;
+    }
+    return false;
+}
@@ -0,0 +1,297 @@
+// Project: Maximum Independent Set (MIS, version 5)
+// Computer Science (2016-2017), 4th semester
+// Author: Guillaume Cocatre-Zilgien
+// Professor: Michel Ventou
+
+#include <cstring>
+#include <future>
+#include <thread>
+#include "BitGraph.hpp"
+
+using namespace std;
+
+// Only enabled vertices are part of the initial set of remaining vertices
+BitGraph::BitGraph(Graph &g) : bestSize {0}, pendingTasks {0}, idleWorkers {0}, sharedTasks {0}, hasDeadline {false},
+                                stopped {false}, openBound {0}
+{
+    this->size = g.getSize();
+    this->words = (this->size + WORD_BITS - 1) / WORD_BITS;
+    this->adjacency.assign(this->size * this->words, 0);
+    this->root.assign(this->words, 0);
+
+    for (vid v = 0; v < this->size; ++v) {
+        if (!g[v].isEnabled()) continue;
+        this->root[v / WORD_BITS] |= (word) 1 << (v % WORD_BITS);
+        word *row {this->getRow(v)};
+        for (auto &w : g.getNeighbors(v)) {
+            row[w / WORD_BITS] |= (word) 1 << (w % WORD_BITS);
+        }
+    }
+}
+
+score BitGraph::getDegree(vid v, const word *set)
+{
+    const word *row {this->getRow(v)};
+    score degree {0};
+    for (cardinal i = 0; i < this->words; ++i) {
+        degree += (score) __builtin_popcountll(row[i] & set[i]);
+    }
+    return degree;
+}
+
+void BitGraph::updateMIS(const vector<vid> &selected)
+{
+    lock_guard<mutex> guard(this->lockMIS);
+    if (selected.size() > this->MIS.size()) {
+        this->MIS = vidSet(selected.cbegin(), selected.cend());
+        this->bestSize.store(this->MIS.size());
+    }
+}
+
+// The clock is only read every few calls, by each worker: once one of them sees the deadline, they all stop
+bool BitGraph::isPastDeadline(Worker &worker)
+{
+    if (this->hasDeadline && !this->stopped.load(memory_order_relaxed) && worker.deadlineCountdown-- == 0) {
+        worker.deadlineCountdown = DEADLINE_CHECK_INTERVAL;
+        if (Time::now() >= this->deadline) this->stopped.store(true);
+    }
+    return this->stopped.load(memory_order_relaxed);
+}
+
+void BitGraph::abandon(cardinal bound)
+{
+    lock_guard<mutex> guard(this->lockMIS);
+    if (bound > this->openBound) {
+        this->openBound = bound;
+    }
+}
+
+/**
+ *  The owner of a deque works on its most recent task (the smallest one), while thieves take the oldest task
+ *  (the largest one, closest to the root of the search tree) so that stealing happens as rarely as possible.
+ */
+bool BitGraph::getTask(Worker &worker, Task &task)
+{
+    {
+        lock_guard<mutex> guard(worker.lock);
+        if (!worker.tasks.empty()) {
+            task = move(worker.tasks.back());
+            worker.tasks.pop_back();
+            return true;
+        }
+    }
+    for (auto &victim : this->workers) {
+        if (victim.get() == &worker) continue;
+        lock_guard<mutex> guard(victim->lock);
+        if (!victim->tasks.empty()) {
+            task = move(victim->tasks.front());
+            victim->tasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ *  A worker that finds no task sleeps until another worker shares one, or until the last task is solved. The number of
+ *  shared tasks is read before looking for a task: if one is shared after the deques were searched, it has changed, and
+ *  the worker does not go to sleep.
+ */
+void BitGraph::runWorker(Worker &worker)
+{
+    Task task;
+    bool idle {false};
+    while (this->pendingTasks.load() > 0) {
+        unsigned long long shared {this->sharedTasks.load()};
+        if (this->getTask(worker, task)) {
+            if (idle) {
+                --this->idleWorkers;
+                idle = false;
+            }
+            if (this->stopped.load(memory_order_relaxed)) { // tasks that are left are abandoned
+                cardinal bound {task.selected.size()};
+                for (auto &bits : task.remaining) bound += (cardinal) __builtin_popcountll(bits);
+                this->abandon(bound);
+            } else {
+                memcpy(this->getRemaining(worker, 0), task.remaining.data(), this->words * sizeof(word));
+                worker.selected = task.selected;
+                this->search(worker, 0);
+            }
+            if (--this->pendingTasks == 0) {
+                lock_guard<mutex> guard(this->lockIdle);
+                this->taskAvailable.notify_all();
+            }
+        } else {
+            if (!idle) {
+                ++this->idleWorkers;
+                idle = true;
+            }
+            unique_lock<mutex> guard(this->lockIdle);
+            this->taskAvailable.wait(guard, [this, shared]() {
+                return this->sharedTasks.load() != shared || this->pendingTasks.load() == 0;
+            });
+        }
+    }
+    if (idle) {
+        --this->idleWorkers;
+    }
+}
+
+/**
+ *  Same principle as Graph::findExactMIS(): isolated vertices and vertices with a degree of 1 are always part of
+ *  a MIS, so they are selected directly. We then branch on the vertex with the highest degree: first without it,
+ *  then with it (its neighbors are removed). A branch is ignored if all of its remaining vertices, added to the
+ *  vertices selected so far, cannot beat the largest MIS found yet.
+ *
+ *  If another worker is idle and this worker has no task left to give away, the second branch becomes a new task
+ *  instead of being explored right after the first one.
+ *
+ *  Once the deadline has passed, the branches that are left are abandoned, and only their upper bounds are kept.
+ */
+void BitGraph::search(Worker &worker, cardinal depth)
+{
+    ++worker.numberOfCalls;
+    word *set {this->getRemaining(worker, depth)};
+    vector<vid> &selected {worker.selected};
+    if (this->isPastDeadline(worker)) {
+        cardinal bound {selected.size()};
+        for (cardinal i = 0; i < this->words; ++i) bound += (cardinal) __builtin_popcountll(set[i]);
+        this->abandon(bound);
+        return;
+    }
+    cardinal selectedBefore {selected.size()}, count {0};
+    vid candidate {NO_VERTEX_FOUND};
+    score degree, maxDegree {0};
+    bool reduced {true};
+
+    while (reduced) {
+        reduced = false;
+        candidate = NO_VERTEX_FOUND;
+        maxDegree = 0;
+        count = 0;
+        for (cardinal i = 0; i < this->words && !reduced; ++i) {
+            word bits {set[i]};
+            while (bits != 0) {
+                vid v {(vid) (i * WORD_BITS + __builtin_ctzll(bits))};
+                bits &= bits - 1;
+                degree = this->getDegree(v, set);
+                if (degree <= 1) {
+                    if (degree == 1) { // remove its only neighbor, then start over (degrees have changed)
+                        const word *row {this->getRow(v)};
+                        for (cardinal j = 0; j < this->words; ++j) set[j] &= ~row[j];
+                        reduced = true;
+                    }
+                    set[i] &= ~((word) 1 << (v % WORD_BITS));
+                    selected.push_back(v);
+                    if (reduced) break;
+                } else {
+                    ++count;
+                    if (degree > maxDegree) {
+                        candidate = v;
+                        maxDegree = degree;
+                    }
+                }
+            }
+        }
+    }
+
+    if (count == 0) { // terminal condition
+        if (selected.size() > this->bestSize.load(memory_order_relaxed)) {
+            this->updateMIS(selected);
+        }
+    } else if (selected.size() + count > this->bestSize.load(memory_order_relaxed)) {
+        word *next {this->getRemaining(worker, depth + 1)};
+        word mask {(word) 1 << (candidate % WORD_BITS)};
+        const word *row {this->getRow(candidate)};
+        bool share {false};
+
+        if (this->idleWorkers.load(memory_order_relaxed) > 0
+            && selected.size() + count - maxDegree > this->bestSize.load(memory_order_relaxed)) {
+            lock_guard<mutex> guard(worker.lock);
+            if (worker.tasks.empty()) {
+                Task task;
+                task.remaining.assign(set, set + this->words);
+                for (cardinal i = 0; i < this->words; ++i) task.remaining[i] &= ~row[i];
+                task.remaining[candidate / WORD_BITS] &= ~mask;
+                task.selected = selected;
+                task.selected.push_back(candidate);
+                ++this->pendingTasks;
+                worker.tasks.push_back(move(task));
+                share = true;
+            }
+        }
+        if (share) {
+            {
+                lock_guard<mutex> guard(this->lockIdle);
+                ++this->sharedTasks;
+            }
+            this->taskAvailable.notify_one();
+        }
+
+        // Disable the vertex with the highest degree
+        memcpy(next, set, this->words * sizeof(word));
+        next[candidate / WORD_BITS] &= ~mask;
+        this->search(worker, depth + 1);
+
+        // Keep the vertex with the highest degree (disable its neighbors)
+        if (!share && this->stopped.load(memory_order_relaxed)) {
+            this->abandon(selected.size() + count - maxDegree);
+        } else if (!share && selected.size() + count - maxDegree > this->bestSize.load(memory_order_relaxed)) {
+            for (cardinal i = 0; i < this->words; ++i) next[i] = set[i] & ~row[i];
+            next[candidate / WORD_BITS] &= ~mask;
+            selected.push_back(candidate);
+            this->search(worker, depth + 1);
+        }
+    }
+
+    selected.resize(selectedBefore);
+}
+
+vidSet BitGraph::findMIS(const vidSet &initial, unsigned threads)
+{
+    this->MIS = initial;
+    this->bestSize.store(initial.size());
+    if (threads < 1) threads = 1;
+
+    this->workers.clear();
+    for (unsigned i = 0; i < threads; ++i) {
+        this->workers.push_back(unique_ptr<Worker>(new Worker));
+        Worker &worker {*this->workers.back()};
+        // Every recursive call removes at least one vertex, so the depth never exceeds the number of vertices
+        worker.remaining.assign((this->size + 1) * this->words, 0);
+        worker.selected.reserve(this->size);
+        worker.numberOfCalls = 0;
+        worker.deadlineCountdown = 0;
+    }
+
+    Task task;
+    task.remaining = this->root;
+    this->workers[0]->tasks.push_back(move(task));
+    this->pendingTasks.store(1);
+    this->sharedTasks.store(0);
+
+    vector<future<void>> helpers;
+    for (unsigned i = 1; i < threads; ++i) {
+        helpers.push_back(async(launch::async, &BitGraph::runWorker, this, ref(*this->workers[i])));
+    }
+    this->runWorker(*this->workers[0]);
+    for (auto &helper : helpers) {
+        helper.get();
+    }
+    return this->MIS;
+}
+
+cardinal BitGraph::getUpperBound()
+{
+    lock_guard<mutex> guard(this->lockMIS);
+    return (this->openBound > this->MIS.size()) ? this->openBound : this->MIS.size();
+}
+
+unsigned long long BitGraph::getNumberOfCalls()
+{
+    unsigned long long calls {0};
+    for (auto &worker : this->workers) {
+        calls += worker->numberOfCalls;
+    }
+    return calls;
+}
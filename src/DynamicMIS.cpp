@@ -0,0 +1,267 @@
+// Project: Maximum Independent Set (MIS, version 5)
+// Computer Science (2016-2017), 4th semester
+// Author: Guillaume Cocatre-Zilgien
+// Professor: Michel Ventou
+
+#include <algorithm>
+#include <cstdio>
+#include "DynamicMIS.hpp"
+#include "Timer.hpp"
+
+using namespace std;
+
+DynamicMIS::DynamicMIS(Graph &g, unsigned interval) : graph {g}, size {0}, stamp {0}, resolveInterval {interval},
+                                                      resolvedSize {0}, sinceResolve {0}, numberOfUpdates {0},
+                                                      numberOfIgnored {0}, numberOfSwaps {0}, numberOfResolves {0},
+                                                      resolveSeconds {0.0}
+{
+    Timer t;
+    this->graph.clearMIS();
+    this->reset(this->graph.findMIS(ALGO_BEST));
+    this->resolvedSize = this->size;
+    printf("Initial set: %lu vertices in %.1f ms\n", this->size, t.countMilliseconds());
+}
+
+void DynamicMIS::reset(const vidSet &set)
+{
+    cardinal n {this->graph.getSize()};
+    this->inSet.assign(n, false);
+    this->tightness.assign(n, 0);
+    this->mate.assign(n, 0);
+    this->queued.assign(n, false);
+    this->marks.assign(n, 0);
+    this->size = 0;
+    for (vid v : set) {
+        this->addToSet(v);
+    }
+}
+
+void DynamicMIS::addToSet(vid v)
+{
+    this->inSet[v] = true;
+    ++this->size;
+    for (auto &w : this->graph.getNeighbors(v)) {
+        ++this->tightness[w];
+        this->mate[w] ^= v;
+    }
+}
+
+void DynamicMIS::removeFromSet(vid v)
+{
+    this->inSet[v] = false;
+    --this->size;
+    for (auto &w : this->graph.getNeighbors(v)) {
+        --this->tightness[w];
+        this->mate[w] ^= v;
+        this->touched.push_back(w);
+    }
+    this->touched.push_back(v);
+}
+
+void DynamicMIS::enqueue(vid x)
+{
+    if (!this->inSet[x] || this->queued[x]) return;
+    this->queued[x] = true;
+    this->candidates.push_back(x);
+}
+
+// Same (1,2)-swap as LocalSearch::swapVertex(), on the rows of the graph itself
+bool DynamicMIS::swapVertex(vid x)
+{
+    this->oneTight.clear();
+    for (auto &w : this->graph.getNeighbors(x)) {
+        if (!this->inSet[w] && this->tightness[w] == 1) this->oneTight.push_back(w);
+    }
+    if (this->oneTight.size() < 2) return false;
+
+    for (cardinal i = 0; i + 1 < this->oneTight.size(); ++i) {
+        vid u {this->oneTight[i]};
+        if (++this->stamp == 0) { // the stamp wrapped around: old marks must be erased
+            this->marks.assign(this->marks.size(), 0);
+            this->stamp = 1;
+        }
+        for (auto &w : this->graph.getNeighbors(u)) {
+            this->marks[w] = this->stamp;
+        }
+        for (cardinal j = i + 1; j < this->oneTight.size(); ++j) {
+            vid w {this->oneTight[j]};
+            if (this->marks[w] != this->stamp) {
+                this->removeFromSet(x);
+                this->addToSet(u);
+                this->addToSet(w);
+                ++this->numberOfSwaps;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+/**
+ *  The touched vertices that have no neighbor in the set join it. Then the vertices of the set next to them (a touched
+ *  vertex of the set, or the only neighbor in the set of a 1-tight one) are tried for a (1,2)-swap; a swap touches the
+ *  neighbors of the vertex that left the set, so the repair goes on around them. Each swap makes the set larger.
+ */
+void DynamicMIS::repair()
+{
+    while (!this->touched.empty()) {
+        vector<vid> around;
+        around.swap(this->touched);
+        for (vid v : around) {
+            if (this->graph.isVertexEnabled(v) && !this->inSet[v] && this->tightness[v] == 0) this->addToSet(v);
+        }
+        for (vid v : around) {
+            if (!this->graph.isVertexEnabled(v)) continue;
+            if (this->inSet[v]) {
+                this->enqueue(v);
+            } else if (this->tightness[v] == 1) {
+                this->enqueue(this->mate[v]);
+            }
+        }
+        while (!this->candidates.empty() && this->touched.empty()) {
+            vid x {this->candidates.back()};
+            this->candidates.pop_back();
+            this->queued[x] = false;
+            if (this->inSet[x]) this->swapVertex(x);
+        }
+    }
+}
+
+double DynamicMIS::resolve()
+{
+    Timer t;
+    cardinal before {this->size};
+    this->graph.clearMIS();
+    vidSet set {this->graph.findMIS(ALGO_BEST)};
+    if (set.size() > this->size) this->reset(set);
+    this->resolvedSize = this->size;
+    this->sinceResolve = 0;
+    ++this->numberOfResolves;
+    double seconds {t.countSeconds()};
+    this->resolveSeconds += seconds;
+    this->printRow();
+    printf("  (re-solved: %lu -> %lu in %.1f ms)\n", before, this->size, seconds * 1000.0);
+    return seconds;
+}
+
+void DynamicMIS::printRow()
+{
+    cardinal n {0};
+    for (vid v = 0; v < this->graph.getSize(); ++v) {
+        if (this->graph.isVertexEnabled(v)) ++n;
+    }
+    printf("%12llu %10lu %10u %10lu", this->numberOfUpdates, n, this->graph.getNumberOfEdges(), this->size);
+}
+
+/**
+ *  An update that does not change the graph (an edge that is already there, or that is not, a vertex that was removed)
+ *  is ignored. The set is updated before the graph when an edge or a vertex goes away, and after it otherwise, so that
+ *  the tightness of every vertex always matches the rows of the graph.
+ */
+bool DynamicMIS::update(const string &line)
+{
+    cardinal n {this->graph.getSize()};
+    unsigned a, b;
+    vid u, v;
+    Timer t;
+    if (sscanf(line.c_str(), "+e %u %u", &a, &b) == 2 || sscanf(line.c_str(), "-e %u %u", &a, &b) == 2) {
+        if (a == 0 || b == 0 || a > n || b > n || a == b) return false;
+        u = a - 1, v = b - 1;
+        if (!this->graph.isVertexEnabled(u) || !this->graph.isVertexEnabled(v)) return false;
+        bool connected {this->graph.areVerticesConnected(u, v)};
+        if (line[0] == '+') {
+            if (connected) return false;
+            this->graph.connectVertices(u, v);
+            for (auto &p : {make_pair(u, v), make_pair(v, u)}) {
+                if (this->inSet[p.first]) {
+                    ++this->tightness[p.second];
+                    this->mate[p.second] ^= p.first;
+                }
+            }
+            if (this->inSet[u] && this->inSet[v]) { // the vertex with fewer neighbors stays
+                this->removeFromSet((this->graph[u].getDegree() > this->graph[v].getDegree()) ? u : v);
+            }
+        } else {
+            if (!connected) return false;
+            for (auto &p : {make_pair(u, v), make_pair(v, u)}) {
+                if (this->inSet[p.first]) {
+                    --this->tightness[p.second];
+                    this->mate[p.second] ^= p.first;
+                }
+            }
+            this->graph.disconnectVertices(u, v);
+        }
+        this->touched.push_back(u);
+        this->touched.push_back(v);
+    } else if (line.compare(0, 2, "+v") == 0) {
+        v = this->graph.addVertex();
+        this->inSet.push_back(false);
+        this->tightness.push_back(0);
+        this->mate.push_back(0);
+        this->queued.push_back(false);
+        this->marks.push_back(0);
+        this->touched.push_back(v);
+    } else if (sscanf(line.c_str(), "-v %u", &a) == 1) {
+        if (a == 0 || a > n || !this->graph.isVertexEnabled(a - 1)) return false;
+        u = a - 1;
+        if (this->inSet[u]) this->removeFromSet(u);
+        this->graph.removeVertex(u);
+    } else {
+        return false;
+    }
+    this->repair();
+    this->latencies.push_back(t.countSeconds() * 1e6);
+    return true;
+}
+
+/**
+ *  Blank lines and comments ("c" or "#") are skipped. The size of the graph and of the set is printed at each re-solve,
+ *  then the distribution of the time taken by the updates: the update that triggers a re-solve waits for it, so the
+ *  re-solve is counted in its latency. A set that keeps shrinking does not trigger a re-solve more often than every
+ *  MIN_RESOLVE_GAP updates, or a small set (where a single vertex is more than 1%) would be solved again every time.
+ */
+void DynamicMIS::run(istream &stream)
+{
+    string line;
+    unsigned long long lineNumber {0};
+    printf("\n%12s %10s %10s %10s\n", "updates", "vertices", "edges", "set");
+    while (getline(stream, line)) {
+        ++lineNumber;
+        if (line.empty() || line[0] == 'c' || line[0] == '#') continue;
+        if (!this->update(line)) {
+            if (this->numberOfIgnored++ < 10) {
+                fprintf(stderr, "Ignored update at line %llu: %s\n", lineNumber, line.c_str());
+            }
+            continue;
+        }
+        ++this->numberOfUpdates;
+        ++this->sinceResolve;
+        if ((this->resolveInterval > 0 && this->sinceResolve >= this->resolveInterval)
+            || (this->sinceResolve >= MIN_RESOLVE_GAP && this->size < this->resolvedSize * (1.0 - RESOLVE_DROP))) {
+            this->latencies.back() += this->resolve() * 1e6;
+        }
+    }
+    this->printRow();
+    printf("\n\nUpdates: %llu applied, %llu ignored, %llu swaps, %llu re-solves (%.1f ms in all)\n",
+        this->numberOfUpdates, this->numberOfIgnored, this->numberOfSwaps, this->numberOfResolves,
+        this->resolveSeconds * 1000.0);
+    if (!this->latencies.empty()) {
+        vector<double> sorted(this->latencies);
+        sort(sorted.begin(), sorted.end());
+        auto percentile = [&sorted](double p) {
+            return sorted[min(sorted.size() - 1, (cardinal) (p * sorted.size()))];
+        };
+        printf("Latency of an update, re-solves included (µs): p50 %.1f, p90 %.1f, p99 %.1f, p99.9 %.1f, max %.1f\n",
+            percentile(0.5), percentile(0.9), percentile(0.99), percentile(0.999), sorted.back());
+    }
+}
+
+vidSet DynamicMIS::getSet() const
+{
+    vidSet set;
+    set.reserve(this->inSet.size());
+    for (vid v = 0; v < this->inSet.size(); ++v) {
+        if (this->inSet[v]) set.insert(v);
+    }
+    return set;
+}
@@ -0,0 +1,290 @@
+// Project: Maximum Independent Set (MIS, version 5)
+// Computer Science (2016-2017), 4th semester
+// Author: Guillaume Cocatre-Zilgien
+// Professor: Michel Ventou
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <thread>
+#include "AdjacencyIndex.hpp"
+#include "Generator.hpp"
+
+using namespace std;
+
+Generator::Generator(cardinal n, unsigned long long seed, unsigned threads) : n {n}, seed {seed}, threads {threads}
+{
+    if (this->threads == 0) this->threads = thread::hardware_concurrency();
+    this->threads = max(1u, min(this->threads, GENERATOR_CHUNKS));
+}
+
+const char * Generator::getName(graphModel model)
+{
+    switch (model) {
+        case MODEL_GNM:       return "gnm";
+        case MODEL_GNP:       return "gnp";
+        case MODEL_GEOMETRIC: return "geometric";
+        case MODEL_CHUNG_LU:  return "chung-lu";
+        case MODEL_RMAT:      return "rmat";
+        default:              return "none";
+    }
+}
+
+// Each part gets a generator seeded with the seed and its own number, whichever thread takes it
+void Generator::runChunks(const function<void(unsigned, mt19937_64 &, vector<vidPair> &)> &work)
+{
+    atomic<unsigned> next {0};
+    auto worker = [this, &work, &next]() {
+        for (unsigned c = next++; c < GENERATOR_CHUNKS; c = next++) {
+            seed_seq sequence {(unsigned) this->seed, (unsigned) (this->seed >> 32), c};
+            mt19937_64 rng(sequence);
+            work(c, rng, this->chunks[c]);
+        }
+    };
+    this->chunks.assign(GENERATOR_CHUNKS, vector<vidPair>());
+    vector<thread> pool;
+    for (unsigned t = 1; t < this->threads; ++t) {
+        pool.push_back(thread(worker));
+    }
+    worker();
+    for (auto &t : pool) {
+        t.join();
+    }
+}
+
+vector<vidPair> Generator::collect()
+{
+    cardinal size {0};
+    for (auto &chunk : this->chunks) {
+        size += chunk.size();
+    }
+    vector<vidPair> edges;
+    edges.reserve(size);
+    for (auto &chunk : this->chunks) {
+        edges.insert(edges.end(), chunk.begin(), chunk.end());
+        vector<vidPair>().swap(chunk);
+    }
+    return edges;
+}
+
+vector<vidPair> Generator::generate(graphModel model, double degree)
+{
+    unsigned long long m {(unsigned long long) (this->n * degree / 2.0 + 0.5)};
+    switch (model) {
+        case MODEL_GNP:       return this->generateGnp((this->n > 1) ? degree / (this->n - 1) : 0.0);
+        case MODEL_GEOMETRIC: return this->generateGeometric(degree);
+        case MODEL_CHUNG_LU:  return this->generateChungLu(degree);
+        case MODEL_RMAT:      return this->generateRMAT(m);
+        default:              return this->generateGnm(m);
+    }
+}
+
+/**
+ *  The pairs (v, w), w < v, are numbered row by row, and the gap between two edges follows a geometric distribution:
+ *  it is drawn directly, so each edge costs O(1), and the pairs that are skipped cost nothing. Each part takes a range
+ *  of rows with about as many pairs as the others (the first rows are the shortest).
+ */
+vector<vidPair> Generator::generateGnp(double p)
+{
+    if (p <= 0.0 || this->n < 2) return vector<vidPair>();
+    cardinal n {this->n};
+    auto row = [n](unsigned c) {
+        return (c == GENERATOR_CHUNKS) ? n : (cardinal) (n * sqrt((double) c / GENERATOR_CHUNKS));
+    };
+    this->runChunks([p, row](unsigned c, mt19937_64 &rng, vector<vidPair> &edges) {
+        long long first {(long long) max((cardinal) 1, row(c))}, last {(long long) row(c + 1)};
+        if (first >= last) return;
+        uniform_real_distribution<double> uniform(0.0, 1.0);
+        double skip {(p < 1.0) ? log(1.0 - p) : 0.0};
+        long long v {first}, w {-1};
+        while (v < last) {
+            w += 1 + ((p < 1.0) ? (long long) floor(log(1.0 - uniform(rng)) / skip) : 0);
+            while (w >= v && v < last) {
+                w -= v;
+                ++v;
+            }
+            if (v < last) edges.push_back(make_pair((vid) v, (vid) w));
+        }
+    });
+    return this->collect();
+}
+
+/**
+ *  Pairs are drawn by their number, and the ones that were already drawn are drawn again: when at most half of the
+ *  pairs are wanted, that happens less than once per edge on average. Denser graphs draw the pairs that are left out.
+ *  The draws depend on each other, so this one runs on a single thread.
+ */
+vector<vidPair> Generator::generateGnm(unsigned long long m)
+{
+    unsigned long long pairs {(unsigned long long) this->n * (this->n - 1) / 2};
+    if (this->n < 2 || m == 0) return vector<vidPair>();
+    m = min(m, pairs);
+    bool complement {m > pairs / 2};
+    unsigned long long draws {complement ? pairs - m : m};
+    AdjacencyIndex drawn(this->n, draws, DEFAULT_MATRIX_THRESHOLD);
+    seed_seq sequence {(unsigned) this->seed, (unsigned) (this->seed >> 32), GENERATOR_CHUNKS};
+    mt19937_64 rng(sequence);
+    uniform_int_distribution<unsigned long long> pick(0, pairs - 1);
+    vector<vidPair> edges;
+    edges.reserve(m);
+    for (unsigned long long count = 0; count < draws;) {
+        unsigned long long i {pick(rng)};
+        vid v {(vid) ((1.0 + sqrt(1.0 + 8.0 * i)) / 2.0)};
+        while ((unsigned long long) v * (v - 1) / 2 > i) --v;
+        while ((unsigned long long) (v + 1) * v / 2 <= i) ++v;
+        vid w {(vid) (i - (unsigned long long) v * (v - 1) / 2)};
+        if (drawn.contains(v, w)) continue;
+        drawn.insert(v, w);
+        if (!complement) edges.push_back(make_pair(v, w));
+        ++count;
+    }
+    if (complement) {
+        for (vid v = 1; v < this->n; ++v) {
+            for (vid w = 0; w < v; ++w) {
+                if (!drawn.contains(v, w)) edges.push_back(make_pair(v, w));
+            }
+        }
+    }
+    return edges;
+}
+
+/**
+ *  The radius gives the average degree, far from the sides of the square. The cells of the grid are as wide as the
+ *  radius, so a vertex can only be connected with the vertices of its own cell and of the 8 cells around it; each
+ *  cell is compared with itself and with 4 of them (right, and the 3 below), so every pair is looked at once.
+ */
+vector<vidPair> Generator::generateGeometric(double degree)
+{
+    if (this->n < 2 || degree <= 0.0) return vector<vidPair>();
+    cardinal n {this->n};
+    double radius {sqrt(degree / (acos(-1.0) * (n - 1)))};
+    cardinal cells {max((cardinal) 1, min((cardinal) (1.0 / radius), (cardinal) sqrt((double) n) + 1))};
+    vector<double> x(n), y(n);
+    this->runChunks([n, &x, &y](unsigned c, mt19937_64 &rng, vector<vidPair> &) {
+        uniform_real_distribution<double> uniform(0.0, 1.0);
+        for (cardinal v = n * c / GENERATOR_CHUNKS; v < n * (c + 1) / GENERATOR_CHUNKS; ++v) {
+            x[v] = uniform(rng);
+            y[v] = uniform(rng);
+        }
+    });
+
+    // Vertices sorted by cell (counting sort), row after row
+    auto cellOf = [cells](double position) { return min(cells - 1, (cardinal) (position * cells)); };
+    vector<cardinal> start(cells * cells + 1, 0);
+    vector<vid> members(n);
+    for (cardinal v = 0; v < n; ++v) {
+        ++start[cellOf(y[v]) * cells + cellOf(x[v]) + 1];
+    }
+    for (cardinal c = 0; c < cells * cells; ++c) {
+        start[c + 1] += start[c];
+    }
+    vector<cardinal> fill(start.begin(), start.end() - 1);
+    for (cardinal v = 0; v < n; ++v) {
+        members[fill[cellOf(y[v]) * cells + cellOf(x[v])]++] = (vid) v;
+    }
+
+    double limit {radius * radius};
+    this->runChunks([&](unsigned c, mt19937_64 &, vector<vidPair> &edges) {
+        auto compare = [&](vid v, cardinal cx, cardinal cy, bool same, cardinal from) {
+            cardinal cell {cy * cells + cx};
+            for (cardinal i = same ? from : start[cell]; i < start[cell + 1]; ++i) {
+                vid w {members[i]};
+                double dx {x[v] - x[w]}, dy {y[v] - y[w]};
+                if (dx * dx + dy * dy < limit) edges.push_back(make_pair(v, w));
+            }
+        };
+        for (cardinal cy = cells * c / GENERATOR_CHUNKS; cy < cells * (c + 1) / GENERATOR_CHUNKS; ++cy) {
+            for (cardinal cx = 0; cx < cells; ++cx) {
+                cardinal cell {cy * cells + cx};
+                for (cardinal i = start[cell]; i < start[cell + 1]; ++i) {
+                    vid v {members[i]};
+                    compare(v, cx, cy, true, i + 1);
+                    if (cx + 1 < cells) compare(v, cx + 1, cy, false, 0);
+                    if (cy + 1 < cells) {
+                        if (cx > 0) compare(v, cx - 1, cy + 1, false, 0);
+                        compare(v, cx, cy + 1, false, 0);
+                        if (cx + 1 < cells) compare(v, cx + 1, cy + 1, false, 0);
+                    }
+                }
+            }
+        }
+    });
+    return this->collect();
+}
+
+/**
+ *  The expected degree of vertex i is proportional to (i + 1)^(-1 / (POWER_LAW_EXPONENT - 1)), so the weights are
+ *  sorted, and the probability of an edge (u, v) only decreases along the row of u: the gaps are drawn as in G(n, p)
+ *  with the probability of the last edge, then each edge is kept with the ratio of the new and old probabilities.
+ *  The parts take ranges of rows with the same total weight (the first rows have the most edges).
+ */
+vector<vidPair> Generator::generateChungLu(double degree)
+{
+    if (this->n < 2 || degree <= 0.0) return vector<vidPair>();
+    cardinal n {this->n};
+    vector<double> weight(n);
+    double total {0.0};
+    for (cardinal v = 0; v < n; ++v) {
+        weight[v] = pow((double) (v + 1), -1.0 / (POWER_LAW_EXPONENT - 1.0));
+        total += weight[v];
+    }
+    double scale {degree * n / total}, sum {degree * n};
+    vector<cardinal> first(GENERATOR_CHUNKS + 1, n);
+    double prefix {0.0};
+    unsigned c {0};
+    for (cardinal v = 0; v < n; ++v) {
+        weight[v] *= scale;
+        while (c < GENERATOR_CHUNKS && prefix >= sum * c / GENERATOR_CHUNKS) first[c++] = v;
+        prefix += weight[v];
+    }
+
+    this->runChunks([n, sum, &weight, &first](unsigned c, mt19937_64 &rng, vector<vidPair> &edges) {
+        uniform_real_distribution<double> uniform(0.0, 1.0);
+        for (cardinal u = first[c]; u < first[c + 1]; ++u) {
+            cardinal v {u + 1};
+            double p {(v < n) ? min(weight[u] * weight[v] / sum, 1.0) : 0.0};
+            while (v < n && p > 0.0) {
+                if (p < 1.0) {
+                    double skip {floor(log(1.0 - uniform(rng)) / log(1.0 - p))};
+                    if (skip >= (double) (n - v)) break;
+                    v += (cardinal) skip;
+                }
+                double q {min(weight[u] * weight[v] / sum, 1.0)};
+                if (uniform(rng) < q / p) edges.push_back(make_pair((vid) u, (vid) v));
+                p = q;
+                ++v;
+            }
+        }
+    });
+    return this->collect();
+}
+
+/**
+ *  Each edge chooses a quadrant of the adjacency matrix (of the next power of 2), then a quadrant of that quadrant,
+ *  and so on; an edge that falls outside of the n first rows or columns is drawn again.
+ */
+vector<vidPair> Generator::generateRMAT(unsigned long long m)
+{
+    if (this->n < 2 || m == 0) return vector<vidPair>();
+    cardinal n {this->n};
+    unsigned levels {0};
+    while (((cardinal) 1 << levels) < n) ++levels;
+    this->runChunks([n, m, levels](unsigned c, mt19937_64 &rng, vector<vidPair> &edges) {
+        uniform_real_distribution<double> uniform(0.0, 1.0);
+        unsigned long long count {m * (c + 1) / GENERATOR_CHUNKS - m * c / GENERATOR_CHUNKS};
+        edges.reserve(count);
+        for (unsigned long long e = 0; e < count; ++e) {
+            cardinal u, v;
+            do {
+                u = v = 0;
+                for (unsigned l = 0; l < levels; ++l) {
+                    double r {uniform(rng)};
+                    u = 2 * u + ((r >= RMAT_A + RMAT_B) ? 1 : 0);
+                    v = 2 * v + ((r >= RMAT_A && r < RMAT_A + RMAT_B) || r >= RMAT_A + RMAT_B + RMAT_C ? 1 : 0);
+                }
+            } while (u >= n || v >= n);
+            edges.push_back(make_pair((vid) u, (vid) v));
+        }
+    });
+    return this->collect();
+}
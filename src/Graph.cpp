@@ -5,11 +5,22 @@
 
 #include <iostream>
 #include <fstream>
+#include <atomic>
+#include <cstring>
 #include <future>
 #include <random>
 #include <stdexcept>
 #include <string>
+#include <thread>
 #include "Graph.hpp"
+#include "BitGraph.hpp"
+#include "Generator.hpp"
+#include "GraphLoader.hpp"
+#include "LocalSearch.hpp"
+#include "Ordering.hpp"
+#include "Reducer.hpp"
+#include "SmallMIS.hpp"
+#include "TranspositionTable.hpp"
 
 using namespace std;
 
@@ -17,7 +28,32 @@ using namespace std;
 Graph::Graph(cardinal n)
 {
     Vertex vertex;
+    this->numberOfCalls = 0;
+    this->numberOfCuts = 0;
+    this->numberOfTableHits = 0;
+    this->numberOfTableMisses = 0;
+    this->unusedEntries = 0;
+    this->matrixThreshold = DEFAULT_MATRIX_THRESHOLD;
+    this->numberOfCliques = 0;
     this->numberOfEdges = 0;
+    this->lowerBound = 0;
+    this->recordTrail = false;
+    this->numberOfThreads = 1;
+    this->maxDegree = 0;
+    this->table = nullptr;
+    this->tableSize = DEFAULT_TABLE_SIZE;
+    this->tableThreshold = DEFAULT_TABLE_THRESHOLD;
+    this->hasDeadline = false;
+    this->deadlineCountdown = 0;
+    this->stopped = false;
+    this->openBound = 0;
+    this->recordSupports = false;
+    this->searchIterations = DEFAULT_SEARCH_ITERATIONS;
+    this->searchSeconds = 0.0;
+    this->portfolioThreads = 1;
+    this->portfolioSeconds = DEFAULT_PORTFOLIO_TIME;
+    this->numberOfRestarts = 0;
+    this->seed = mt19937::default_seed;
     if (n == RANDOM_NUMBER_OF_VERTICES) {
         n = this->getRandomNumber(2, 40);
     }
@@ -27,110 +63,60 @@ Graph::Graph(cardinal n)
     for (vid v = 0; v < n; ++v) {
         this->vertices[v].id = v;
     }
+    this->initializeBuckets();
+}
+
+// Constructor with the cardinality of a set and a list of edges (vertices numbered from 0) as arguments
+Graph::Graph(cardinal n, const vector<vidPair> &edges) : Graph(n)
+{
+    this->buildAdjacency(edges);
 }
 
 // Constructor with the path to a file containing a graph as argument
-Graph::Graph(const char *path)
+Graph::Graph(const char *path) : Graph(GraphLoader(path))
 {
-    this->numberOfEdges = 0;
-    this->enabledCardinal = 0;
-
-    bool invalid {false};
-    ifstream file;
-    file.open(path, ios::in);
-    if (file.is_open()) {
-        unsigned n {0}, e {0};
-        vid v, w;
-        string line;
-        while (getline(file, line)) {
-            if (n == 0) {
-                if (line.compare(0,2,"c ") == 0) continue;
-
-                if (sscanf(line.c_str(), "p edge %u %u", &n, &e) != 2) {
-                    if (sscanf(line.c_str(), "p col %u %u", &n, &e) != 2) {
-                        try { n = (unsigned) stoul(line); } catch (...) { n = 0; }
-                    }
-                }
+}
 
-                if (n != 0) {
-                    Vertex vertex;
-                    this->enabledCardinal = n;
-                    this->vertices.resize(n, vertex);
-                    for (vid v = 0; v < n; ++v) {
-                        this->vertices[v].id = v;
-                    }
-                }
-            } else {
-                if (line.compare(0,3,"MIS") == 0) {
-                    break;
-                } else if (sscanf(line.c_str(), "e %u %u", &v, &w) == 2 || sscanf(line.c_str(), "%u %u", &v, &w) == 2) {
-                    if (v > 0 && w > 0) {
-                        this->connectVertices((v-1), (w-1));
-                    } else {
-                        invalid = true;
-                        break;
-                    }
-                }
-            }
-        }
-        file.close();
-        if (invalid) {
-            cerr << "Error: invalid file " << path << endl;
-            this->vertices.clear();
-            this->enabledCardinal = 0;
-            this->numberOfEdges = 0;
-        }
+// Constructor with the edges read by a loader as argument (see GraphLoader)
+Graph::Graph(const GraphLoader &loader) : Graph(loader.isValid() ? loader.getNumberOfVertices() : 0)
+{
+    if (loader.isSnapshot()) {
+        this->loadSnapshot(loader);
+    } else if (loader.isValid()) {
+        this->buildAdjacency(loader.getEdges());
+    } else if (loader.isOpen()) {
+        cerr << "Error: invalid file " << loader.getPath() << endl;
     } else {
-        cerr << "Error: unable to open file " << path << endl;
+        cerr << "Error: unable to open file " << loader.getPath() << endl;
     }
 }
 
+// Each graph has its own generator (copies start from the same state), so threads never share one
 unsigned Graph::getRandomNumber(unsigned min, unsigned max)
 {
-    static std::mt19937 rng;
-    static bool seeded {false};
-    if (!seeded) {
-        rng.seed(std::random_device()());
-    }
-    std::uniform_int_distribution<std::mt19937::result_type> dist(min, max);
-    return (unsigned) dist(rng);
+    uniform_int_distribution<unsigned> dist(min, max);
+    return dist(this->rng);
 }
 
+/**
+ *  Exactly as many edges as the percentage of all the pairs of vertices, drawn at random (G(n, m), see Generator):
+ *  the graph is built from the list of edges in one go.
+ */
 unsigned Graph::connectRandomly(float percentage)
 {
     if (percentage < 1.0 || percentage > 100.0) {
         percentage = (float) this->getRandomNumber(1, 100);
     }
+    unsigned long long m {(unsigned long long) (percentage * this->getMaxNumberOfEdges() / 100.0 + 0.5)};
+    Generator generator(this->vertices.size(), this->rng());
+    this->buildAdjacency(generator.generateGnm(m));
+    return this->numberOfEdges;
+}
 
-    unsigned max = (unsigned) (this->vertices.size() * (this->vertices.size() - 1)) / 2;
-    unsigned n = (unsigned) ((percentage * max / 100.0) + 0.5);
-    unsigned p, maxPairIndex = (max - 1);
-    vid v, w, maxVid = (vid) (this->vertices.size() - 1);
-
-    if (this->numberOfEdges > 0) {
-        for (auto &vertex : this->vertices) {
-            this->disconnectVertex(vertex.id);
-        }
-    }
-
-    // Generate the complete list of vertices that can be connected
-    vector<pair<vid, vid>> pairs;
-    for (v = 0; v < maxVid; ++v) {
-        for (w = v + 1; w <= maxVid; ++w) {
-            pairs.push_back(make_pair(v, w));
-        }
-    }
-
-    // Randomly select two vertices to connect together
-    while (this->numberOfEdges < n) {
-        do {
-            p = this->getRandomNumber(0, maxPairIndex);
-        } while (pairs[p].second == 0);
-        this->connectVertices(pairs[p].first, pairs[p].second);
-        // It is faster to flag a couple of vertices as being "unavailable", than to erase them from the vector.
-        pairs[p].second = 0;
-    }
-
+unsigned Graph::connectRandomly(graphModel model, double degree)
+{
+    Generator generator(this->vertices.size(), this->rng());
+    this->buildAdjacency(generator.generate(model, degree));
     return this->numberOfEdges;
 }
 
@@ -141,7 +127,7 @@ void Graph::print()
         if (vertex.isIsolated()) {
             cout << vertex.id + 1 << "\n";
         } else {
-            for (auto &w : vertex.neighbors) {
+            for (auto &w : this->getNeighbors(vertex.id)) {
                 if (w > vertex.id) {
                     cout << vertex.id + 1 << " " << w + 1 << "\n";
                 }
@@ -151,161 +137,604 @@ void Graph::print()
     cout << flush;
 }
 
+void Graph::initializeBuckets()
+{
+    this->buckets.assign(this->vertices.size() + 1, NO_VERTEX_FOUND);
+    this->maxDegree = 0;
+    this->kernelCardinal = 0;
+    for (auto &vertex : this->vertices) {
+        this->linkVertex(vertex.id);
+    }
+}
+
+/**
+ *  Enabled vertices are kept in doubly-linked lists, one per degree: the links are stored in the vertices themselves,
+ *  so moving a vertex to another bucket when its degree changes costs O(1), and nothing is ever allocated.
+ *  The vertices that are not isolated (the kernel) are counted at the same time.
+ */
+void Graph::linkVertex(vid v)
+{
+    Vertex &vertex {this->vertices[v]};
+    if (!vertex.enabled) return;
+    if (vertex.degree >= this->buckets.size()) { // only possible if some edges were given twice
+        this->buckets.resize(vertex.degree + 1, NO_VERTEX_FOUND);
+    }
+    vid &head {this->buckets[vertex.degree]};
+    vertex.previous = NO_VERTEX_FOUND;
+    vertex.next = head;
+    if (head != NO_VERTEX_FOUND) this->vertices[head].previous = v;
+    head = v;
+    if (vertex.degree > this->maxDegree) this->maxDegree = vertex.degree;
+    if (vertex.degree > 0) ++this->kernelCardinal;
+}
+
+void Graph::unlinkVertex(vid v, score degree)
+{
+    Vertex &vertex {this->vertices[v]};
+    if (!vertex.enabled) return;
+    if (vertex.previous != NO_VERTEX_FOUND) {
+        this->vertices[vertex.previous].next = vertex.next;
+    } else {
+        this->buckets[degree] = vertex.next;
+    }
+    if (vertex.next != NO_VERTEX_FOUND) this->vertices[vertex.next].previous = vertex.previous;
+    if (degree > 0) --this->kernelCardinal;
+}
+
+/**
+ *  The rows are built once, with exactly as many entries as neighbors: every vertex gets its neighbors in the order of
+ *  the list of edges, and goes into its degree bucket in the order in which its last edge was given, as if the vertices
+ *  had been connected one by one (the heuristics break ties with the order of the buckets). Self-loops and edges that
+ *  are given more than once (both are found in real files) are dropped afterwards.
+ */
+void Graph::buildAdjacency(const vector<vidPair> &edges)
+{
+    cardinal offset {0};
+    vector<vid> order;
+    vector<bool> seen(this->vertices.size(), false);
+    for (auto &vertex : this->vertices) {
+        vertex.degree = 0;
+    }
+    this->initializeBuckets();
+    for (auto it = edges.crbegin(); it != edges.crend(); ++it) {
+        for (vid v : {it->second, it->first}) {
+            if (!seen[v]) {
+                seen[v] = true;
+                order.push_back(v);
+            }
+        }
+    }
+    for (auto &edge : edges) {
+        ++this->vertices[edge.first].degree;
+        ++this->vertices[edge.second].degree;
+    }
+    for (auto &vertex : this->vertices) {
+        vertex.offset = offset;
+        vertex.capacity = vertex.degree;
+        offset += vertex.degree;
+        vertex.degree = 0;
+    }
+    this->adjacency.assign(offset, 0);
+    this->unusedEntries = 0;
+    for (auto &edge : edges) {
+        Vertex &v {this->vertices[edge.first]}, &w {this->vertices[edge.second]};
+        this->adjacency[v.offset + v.degree++] = edge.second;
+        this->adjacency[w.offset + w.degree++] = edge.first;
+    }
+
+    // Self-loops and repeated edges are dropped (the first occurrence of a neighbor is kept)
+    cardinal entries {0};
+    vector<vid> stamps(this->vertices.size(), NO_VERTEX_FOUND);
+    for (auto &vertex : this->vertices) {
+        vid *row {this->adjacency.data() + vertex.offset};
+        cardinal kept {0};
+        for (cardinal i = 0; i < vertex.degree; ++i) {
+            if (row[i] == vertex.id || stamps[row[i]] == vertex.id) continue;
+            stamps[row[i]] = vertex.id;
+            row[kept++] = row[i];
+        }
+        vertex.degree = kept;
+        entries += kept;
+    }
+    this->numberOfEdges = (unsigned) (entries / 2);
+    if (entries < this->adjacency.size()) this->compactAdjacency();
+    for (auto it = order.crbegin(); it != order.crend(); ++it) {
+        this->unlinkVertex(*it, 0);
+        this->linkVertex(*it);
+    }
+    this->indexAdjacency();
+}
+
+/**
+ *  The rows of a snapshot have no unused entry, and are copied in one go. The vertices with neighbors are then moved
+ *  from the bucket of degree 0 to their own bucket in the order that was saved, so that every bucket lists its vertices
+ *  in the same order as in the graph that was saved (and the heuristics make the same choices).
+ */
+void Graph::loadSnapshot(const GraphLoader &loader)
+{
+    const uint64_t *offsets {loader.getOffsets()};
+    const vid *links {loader.getLinks()};
+    this->adjacency.assign(loader.getAdjacency(), loader.getAdjacency() + loader.getNumberOfEntries());
+    this->unusedEntries = 0;
+    for (auto &vertex : this->vertices) {
+        vertex.degree = 0;
+    }
+    this->initializeBuckets();
+    for (auto &vertex : this->vertices) {
+        vertex.offset = offsets[vertex.id];
+        vertex.capacity = vertex.degree = (score) (offsets[vertex.id + 1] - offsets[vertex.id]);
+    }
+    this->numberOfEdges = (unsigned) (loader.getNumberOfEntries() / 2);
+    for (cardinal i = loader.getNumberOfLinks(); i-- > 0;) {
+        this->unlinkVertex(links[i], 0);
+        this->linkVertex(links[i]);
+    }
+    this->indexAdjacency();
+}
+
+/**
+ *  Disabling vertices and rolling them back never changes the index: an edge whose vertices are both enabled is always
+ *  there (see areVerticesConnected()). Only edges that are added or removed on purpose change it.
+ */
+void Graph::indexAdjacency()
+{
+    this->adjacencyIndex = make_shared<AdjacencyIndex>(this->vertices.size(), this->numberOfEdges,
+        this->matrixThreshold);
+    for (auto &vertex : this->vertices) {
+        for (auto &w : this->getNeighbors(vertex.id)) {
+            if (w > vertex.id) this->adjacencyIndex->insert(vertex.id, w);
+        }
+    }
+}
+
+// Copies of a graph (the heuristics work on copies) share its index, until one of them adds or removes an edge
+AdjacencyIndex * Graph::getWritableIndex()
+{
+    if (this->adjacencyIndex && this->adjacencyIndex.use_count() > 1) {
+        this->adjacencyIndex = make_shared<AdjacencyIndex>(*this->adjacencyIndex);
+    }
+    return this->adjacencyIndex.get();
+}
+
+void Graph::setMatrixThreshold(cardinal threshold)
+{
+    this->matrixThreshold = threshold;
+    if (this->adjacencyIndex) this->indexAdjacency();
+}
+
+// The removed neighbors are dropped, so this is never done while the trail is recorded
+void Graph::compactAdjacency()
+{
+    vector<vid> compact;
+    compact.reserve(2 * this->numberOfEdges);
+    for (auto &vertex : this->vertices) {
+        const vid *row {this->getRow(vertex.id)};
+        cardinal offset {compact.size()};
+        compact.insert(compact.end(), row, row + vertex.degree);
+        vertex.offset = offset;
+        vertex.capacity = vertex.degree;
+    }
+    this->adjacency.swap(compact);
+    this->unusedEntries = 0;
+}
+
+/**
+ *  A new neighbor takes the first entry after the live part of the row (a removed neighbor is then forgotten). A full
+ *  row moves to the end of the adjacency array, with twice as many entries: that is the only part of the array that
+ *  changes once it is built, and once half of it is made of abandoned rows, the whole array is compacted.
+ */
+void Graph::addNeighbor(vid v, vid w)
+{
+    Vertex &vertex {this->vertices[v]};
+    if (vertex.degree == vertex.capacity) {
+        if (!this->recordTrail && 2 * this->unusedEntries > this->adjacency.size()) this->compactAdjacency();
+        score capacity {max(2 * vertex.capacity, MIN_ROW_CAPACITY)};
+        cardinal offset {this->adjacency.size()};
+        this->adjacency.resize(offset + capacity);
+        copy(this->adjacency.begin() + vertex.offset, this->adjacency.begin() + vertex.offset + vertex.capacity,
+            this->adjacency.begin() + offset);
+        this->unusedEntries += vertex.capacity;
+        vertex.offset = offset;
+        vertex.capacity = capacity;
+    }
+    this->getRow(v)[vertex.degree++] = w;
+}
+
+// The neighbor swaps places with the last live one, and becomes the most recent removed neighbor
+void Graph::removeNeighbor(vid v, vid w)
+{
+    Vertex &vertex {this->vertices[v]};
+    vid *row {this->getRow(v)};
+    cardinal i {simd::findVertex(row, vertex.degree, w)};
+    row[i] = row[--vertex.degree];
+    row[vertex.degree] = w;
+}
+
+/**
+ *  The trail puts the edges back in the reverse order of their removal, so the neighbor is almost always the most recent
+ *  removed one (see disableVertex()); otherwise it is looked for among the other removed neighbors, or added again.
+ */
+void Graph::restoreNeighbor(vid v, vid w)
+{
+    Vertex &vertex {this->vertices[v]};
+    vid *row {this->getRow(v)};
+    if (vertex.degree < vertex.capacity && row[vertex.degree] != w) {
+        cardinal i {vertex.degree + simd::findVertex(row + vertex.degree, vertex.capacity - vertex.degree, w)};
+        if (i < vertex.capacity) {
+            row[i] = row[vertex.degree];
+            row[vertex.degree] = w;
+        }
+    }
+    if (vertex.degree < vertex.capacity && row[vertex.degree] == w) {
+        ++vertex.degree;
+    } else {
+        this->addNeighbor(v, w);
+    }
+}
+
 void Graph::connectVertices(vid v, vid w)
 {
-    this->vertices[v].addNeighbor(w);
-    this->vertices[w].addNeighbor(v);
+    this->unlinkVertex(v, this->vertices[v].degree);
+    this->unlinkVertex(w, this->vertices[w].degree);
+    this->addNeighbor(v, w);
+    this->addNeighbor(w, v);
+    if (AdjacencyIndex *index = this->getWritableIndex()) index->insert(v, w);
+    this->linkVertex(v);
+    this->linkVertex(w);
     ++this->numberOfEdges;
 }
 
 void Graph::disconnectVertices(vid v, vid w)
 {
-    this->vertices[v].removeNeighbor(w);
-    this->vertices[w].removeNeighbor(v);
+    this->unlinkVertex(v, this->vertices[v].degree);
+    this->unlinkVertex(w, this->vertices[w].degree);
+    this->removeNeighbor(v, w);
+    this->removeNeighbor(w, v);
+    if (AdjacencyIndex *index = this->getWritableIndex()) index->erase(v, w);
+    this->linkVertex(v);
+    this->linkVertex(w);
     --this->numberOfEdges;
 }
 
 void Graph::disconnectVertex(vid v)
 {
     Vertex &vertex {this->vertices[v]};
+    AdjacencyIndex *index {this->getWritableIndex()};
     this->numberOfEdges -= vertex.degree;
-    for (auto &w : vertex.neighbors) {
-        this->vertices[w].removeNeighbor(v);
+    for (auto &w : this->getNeighbors(v)) {
+        this->unlinkVertex(w, this->vertices[w].degree);
+        this->removeNeighbor(w, v);
+        this->linkVertex(w);
+        if (index) index->erase(v, w);
     }
+    this->unlinkVertex(v, vertex.degree);
     vertex.clearNeighbors();
+    this->linkVertex(v);
+}
+
+/**
+ *  The new vertex gets the next ID. The index makes room for it (see AdjacencyIndex::grow()), unless the graph has
+ *  become too large for a matrix: it is then built again, as a hash set of edges.
+ */
+vid Graph::addVertex()
+{
+    vid v {(vid) this->vertices.size()};
+    this->vertices.push_back(Vertex(v));
+    this->buckets.push_back(NO_VERTEX_FOUND);
+    if (!this->originalID.empty()) this->originalID.push_back(v);
+    ++this->enabledCardinal;
+    this->linkVertex(v);
+    if (this->adjacencyIndex && this->adjacencyIndex->isMatrix()
+        && !this->getWritableIndex()->grow(this->vertices.size())) {
+        this->indexAdjacency();
+    }
+    return v;
+}
+
+// The vertex keeps its ID (and its place in the arrays), but is never part of the graph again
+void Graph::removeVertex(vid v)
+{
+    this->disconnectVertex(v);
+    this->unlinkVertex(v, 0);
+    this->vertices[v].disable();
+    --this->enabledCardinal;
 }
 
 bool Graph::areVerticesConnected(vid v, vid w)
 {
-    if (this->vertices[v].degree < this->vertices[w].degree) {
-        return this->vertices[v].isConnectedTo(w);
-    } else {
-        return this->vertices[w].isConnectedTo(v);
+    if (this->adjacencyIndex) {
+        return this->vertices[v].enabled && this->vertices[w].enabled && this->adjacencyIndex->contains(v, w);
+    }
+    if (this->vertices[v].degree > this->vertices[w].degree) {
+        swap(v, w);
     }
+    return simd::findVertex(this->getRow(v), this->vertices[v].degree, w) < this->vertices[v].degree;
 }
 
 void Graph::disableVertex(vid v)
 {
     Vertex &vertex {this->vertices[v]};
     this->numberOfEdges -= vertex.degree;
-    for (auto &w : vertex.neighbors) {
-        this->vertices[w].removeNeighbor(v);
+    for (auto &w : this->getNeighbors(v)) {
+        this->unlinkVertex(w, this->vertices[w].degree);
+        this->removeNeighbor(w, v);
+        this->linkVertex(w);
+        if (this->recordTrail) this->trail.push_back(make_pair(v, w));
     }
+    if (this->recordSupports) this->updateSupports(v);
+    this->unlinkVertex(v, vertex.degree);
     vertex.disable();
     --this->enabledCardinal;
+    if (this->recordTrail) {
+        this->trail.push_back(make_pair(v, NO_VERTEX_FOUND));
+        if (--this->cliqueSize[this->cliqueOf[v]] == 0) --this->numberOfCliques;
+    }
 }
 
 void Graph::disableVertexNeighborhood(vid v)
 {
     Vertex &vertex {this->vertices[v]};
+    const vid *row {this->getRow(v)};
     this->enabledCardinal -= vertex.degree;
-    for (auto &w : vertex.neighbors) {
+    for (score i = vertex.degree; i-- > 0;) { // backwards, so that rollback() puts them back in the order of the row
+        vid w {row[i]};
         Vertex &neighbor {this->vertices[w]};
         this->numberOfEdges -= neighbor.degree;
-        for (auto &x : neighbor.neighbors) {
+        for (auto &x : this->getNeighbors(w)) {
             if (x != v) { // don't affect the first loop
-                this->vertices[x].removeNeighbor(w);
+                this->unlinkVertex(x, this->vertices[x].degree);
+                this->removeNeighbor(x, w);
+                this->linkVertex(x);
             }
+            if (this->recordTrail) this->trail.push_back(make_pair(w, x));
         }
+        this->unlinkVertex(w, neighbor.degree);
         neighbor.disable();
+        if (this->recordTrail) {
+            this->trail.push_back(make_pair(w, NO_VERTEX_FOUND));
+            if (--this->cliqueSize[this->cliqueOf[w]] == 0) --this->numberOfCliques;
+        }
     }
+    this->unlinkVertex(v, vertex.degree);
     vertex.clearNeighbors();
+    this->linkVertex(v);
 }
 
-void Graph::restoreVertex(Vertex &vertex)
+/**
+ *  The trail is read backwards: a disabled vertex is re-enabled first, then its edges are reconnected.
+ *  Nothing is copied and nothing is searched for (the removed neighbors are still in the rows, see restoreNeighbor()),
+ *  so a rollback costs as much as the removals it undoes.
+ *  A re-enabled vertex only goes back to a degree bucket once all of its edges are reconnected.
+ */
+void Graph::rollback(cardinal mark)
 {
-    if (!this->vertices[vertex.id].enabled) {
-        this->vertices[vertex.id].enabled = true;
-        ++this->enabledCardinal;
-    }
-
-    for (auto &w : vertex.neighbors) {
-        if (!this->vertices[w].enabled) {
-            this->vertices[w].enabled = true;
+    vid pending {NO_VERTEX_FOUND};
+    while (this->trail.size() > mark) {
+        vidPair &entry {this->trail.back()};
+        if (entry.second == NO_VERTEX_FOUND) {
+            if (pending != NO_VERTEX_FOUND) this->linkVertex(pending);
+            pending = entry.first;
+            this->vertices[pending].enabled = true;
             ++this->enabledCardinal;
+            if (this->cliqueSize[this->cliqueOf[pending]]++ == 0) ++this->numberOfCliques;
+        } else {
+            // entry.first is the vertex that was disabled, its edges follow its own entry in the trail: its row was
+            // left as it was, so it gets all of its neighbors back once all of its edges are reconnected
+            this->unlinkVertex(entry.second, this->vertices[entry.second].degree);
+            ++this->vertices[entry.first].degree;
+            this->restoreNeighbor(entry.second, entry.first);
+            this->linkVertex(entry.second);
+            ++this->numberOfEdges;
         }
-        if (!this->areVerticesConnected(vertex.id, w)) {
-            this->connectVertices(vertex.id, w);
-        }
+        this->trail.pop_back();
     }
+    if (pending != NO_VERTEX_FOUND) this->linkVertex(pending);
 }
 
-vid Graph::getMaxDegreeVertex()
+void Graph::initializeCover()
 {
-    vid candidate {NO_VERTEX_FOUND};
-    score maxDegree {0};
+    cardinal n {this->vertices.size()};
+    this->cliqueOf.resize(n);
+    this->cliqueSize.assign(n, 0);
+    this->cliqueHits.assign(n, 0);
+    this->coverTrail.clear();
+    this->numberOfCliques = 0;
     for (auto &vertex : this->vertices) {
-        if (vertex.degree > maxDegree) {
-            candidate = vertex.id;
-            maxDegree = vertex.degree;
+        this->cliqueOf[vertex.id] = vertex.id;
+        if (vertex.enabled) {
+            this->cliqueSize[vertex.id] = 1;
+            ++this->numberOfCliques;
         }
     }
-    return candidate;
 }
 
-vid Graph::getMaxSupportVertex()
+/**
+ *  Greedy clique cover: each enabled vertex joins the first clique whose members are all its neighbors,
+ *  or starts a new clique. A MIS contains at most one vertex of each clique, so the number of cliques is an upper
+ *  bound of its cardinality. Disabling vertices keeps the cover valid (see disableVertex() and rollback()), so it is
+ *  inherited down the search tree, and only rebuilt when it is not tight enough to cut a branch.
+ *  A clique is named after its first vertex; the previous cover is saved in the cover trail.
+ */
+void Graph::coverWithCliques()
 {
-    vid candidate {NO_VERTEX_FOUND};
-    score support, maxSupport {0}, maxDegree {0};
     for (auto &vertex : this->vertices) {
-        if (vertex.isEnabled()) {
-            support = 0;
-            for (auto &w : vertex.neighbors) {
-                support += this->vertices[w].degree;
-            }
+        if (vertex.enabled) {
+            this->coverTrail.push_back({vertex.id, this->cliqueOf[vertex.id], this->cliqueSize[vertex.id]});
+            this->cliqueOf[vertex.id] = NO_VERTEX_FOUND;
+            this->cliqueSize[vertex.id] = 0;
+        }
+    }
 
-            if (support > maxSupport) {
-                candidate = vertex.id;
-                maxSupport = support;
-                maxDegree = vertex.degree;
-            } else if (support == maxSupport && vertex.degree > maxDegree) {
-                candidate = vertex.id;
-                maxDegree = vertex.degree;
+    this->numberOfCliques = 0;
+    for (auto &vertex : this->vertices) {
+        if (!vertex.enabled) continue;
+        vid clique {NO_VERTEX_FOUND}, c;
+        for (auto &w : this->getNeighbors(vertex.id)) {
+            if ((c = this->cliqueOf[w]) != NO_VERTEX_FOUND && ++this->cliqueHits[c] == this->cliqueSize[c]) {
+                clique = c;
             }
         }
+        for (auto &w : this->getNeighbors(vertex.id)) {
+            if ((c = this->cliqueOf[w]) != NO_VERTEX_FOUND) this->cliqueHits[c] = 0;
+        }
+        if (clique == NO_VERTEX_FOUND) {
+            clique = vertex.id;
+            ++this->numberOfCliques;
+        }
+        this->cliqueOf[vertex.id] = clique;
+        ++this->cliqueSize[clique];
     }
-    return candidate;
 }
 
-vid Graph::getMinSupportVertexNeighbor()
+void Graph::restoreCover(cardinal mark)
 {
-    vid candidate {NO_VERTEX_FOUND};
-    score support {0}, minSupport {SCORE_LIMIT};
-    vector<vid> minSupportVertices;
+    while (this->coverTrail.size() > mark) {
+        cliqueEntry &entry {this->coverTrail.back()};
+        this->cliqueOf[entry.v] = entry.clique;
+        this->cliqueSize[entry.v] = entry.size;
+        this->coverTrail.pop_back();
+    }
+}
 
-    // Create a list of vertices with the smallest non-null "support" value
+// Buckets are only skipped after they were emptied by edge removals, so the lookup costs O(1) amortized
+vid Graph::getMaxDegreeVertex()
+{
+    while (this->maxDegree > 0 && this->buckets[this->maxDegree] == NO_VERTEX_FOUND) {
+        --this->maxDegree;
+    }
+    return (this->maxDegree > 0) ? this->buckets[this->maxDegree] : NO_VERTEX_FOUND;
+}
+
+/**
+ *  The support of every vertex is computed once; after that, disableVertex() only updates the supports that changed
+ *  (see updateSupports()). The vertices that are not isolated go into the heap of the heuristic that will use them.
+ */
+void Graph::initializeSupports(algorithm algo)
+{
+    cardinal n {this->vertices.size()};
+    this->supports.assign(n, 0);
+    this->supportChanged.assign(n, false);
+    this->changedSupports.clear();
+    this->maxSupportHeap.reset((algo == ALGO_VSA) ? n : 0);
+    this->minSupportHeap.reset((algo == ALGO_MVSA) ? n : 0);
+    this->recordSupports = true;
+    this->computeSupports();
+}
+
+// Sequential pass over every edge (as in the original heuristics), followed by an O(n) rebuild of the heap
+void Graph::computeSupports()
+{
+    bool maxHeap {this->maxSupportHeap.getCapacity() > 0}, minHeap {this->minSupportHeap.getCapacity() > 0};
+    this->maxSupportHeap.clear();
+    this->minSupportHeap.clear();
+    if (this->vertices.empty()) return;
+    // The degrees are copied side by side, so that the vectorized sum gathers them from one array (with 32-bit indices)
+    bool gather {this->vertices.size() <= (size_t) numeric_limits<int>::max()};
+    if (gather) {
+        this->supportDegrees.resize(this->vertices.size());
+        for (auto &vertex : this->vertices) {
+            this->supportDegrees[vertex.id] = vertex.degree;
+        }
+    }
     for (auto &vertex : this->vertices) {
-        if (vertex.isEnabled() && vertex.degree > 0) {
-            support = 0;
-            for (auto &w : vertex.neighbors) {
+        if (!vertex.isEnabled() || vertex.degree == 0) continue;
+        score support {0};
+        if (gather) {
+            support = simd::sumScores(this->getRow(vertex.id), vertex.degree, this->supportDegrees.data());
+        } else {
+            for (auto &w : this->getNeighbors(vertex.id)) {
                 support += this->vertices[w].degree;
             }
+        }
+        this->supports[vertex.id] = support;
+        if (maxHeap) this->maxSupportHeap.append(vertex.id, make_pair(support, vertex.degree));
+        if (minHeap) this->minSupportHeap.append(vertex.id, support);
+    }
+    this->maxSupportHeap.heapify();
+    this->minSupportHeap.heapify();
+}
+
+/**
+ *  The edges of v were just removed: each neighbor w of v loses the degree of v from its support, and since the degree
+ *  of w went down by one, so does the support of each remaining neighbor of w. That costs O(support(v)), plus O(log n)
+ *  for each vertex whose support changed; the heaps are only updated once every support is up to date.
+ *  Isolated vertices leave the heaps: they are part of the independent set, and no longer candidates.
+ *
+ *  In a dense graph, the support of v is close to the number of edges, and almost every vertex is at a distance of 2
+ *  from v: once it is more than half the number of edges, it is cheaper to compute every support again, with a
+ *  sequential pass over the edges.
+ */
+void Graph::updateSupports(vid v)
+{
+    Vertex &vertex {this->vertices[v]};
+    bool dense {2 * this->supports[v] > this->numberOfEdges};
+    if (dense) this->computeSupports(); // v is not disabled yet, so it goes back into the heaps
+    if (this->maxSupportHeap.contains(v)) this->maxSupportHeap.remove(v);
+    if (this->minSupportHeap.contains(v)) this->minSupportHeap.remove(v);
+    if (dense) return;
+
+    for (auto &w : this->getNeighbors(vertex.id)) {
+        this->supports[w] -= vertex.degree;
+        this->changedSupports.push_back(w);
+        this->supportChanged[w] = true;
+    }
+    for (auto &w : this->getNeighbors(vertex.id)) {
+        for (auto &x : this->getNeighbors(w)) {
+            --this->supports[x];
+            if (!this->supportChanged[x]) {
+                this->supportChanged[x] = true;
+                this->changedSupports.push_back(x);
+            }
+        }
+    }
 
-            if (support < minSupport) {
-                minSupportVertices.clear();
-                minSupportVertices.push_back(vertex.id);
-                minSupport = support;
-            } else if (support == minSupport) {
-                minSupportVertices.push_back(vertex.id);
+    for (auto &w : this->changedSupports) {
+        Vertex &changed {this->vertices[w]};
+        this->supportChanged[w] = false;
+        if (this->maxSupportHeap.contains(w)) {
+            if (changed.degree == 0) {
+                this->maxSupportHeap.remove(w);
+            } else {
+                this->maxSupportHeap.update(w, make_pair(this->supports[w], changed.degree));
+            }
+        }
+        if (this->minSupportHeap.contains(w)) {
+            if (changed.degree == 0) {
+                this->minSupportHeap.remove(w);
+            } else {
+                this->minSupportHeap.update(w, this->supports[w]);
             }
         }
     }
+    this->changedSupports.clear();
+}
+
+// Highest support first, then highest degree, then smallest id (see initializeSupports())
+vid Graph::getMaxSupportVertex()
+{
+    return this->maxSupportHeap.isEmpty() ? NO_VERTEX_FOUND : this->maxSupportHeap.top();
+}
+
+/**
+ *  The vertices with the smallest support are all at the top of the heap (see initializeSupports()), and the supports
+ *  of their neighbors are already known, so a step only costs as much as the degrees of those vertices.
+ *  The candidates are visited in the order of their ids, so that ties are broken as before.
+ */
+vid Graph::getMinSupportVertexNeighbor()
+{
+    vid candidate {NO_VERTEX_FOUND};
+    score minSupport {SCORE_LIMIT};
+
+    // Create a list of vertices with the smallest non-null "support" value
+    this->minSupportHeap.collectTop(this->minSupportVertices);
+    sort(this->minSupportVertices.begin(), this->minSupportVertices.end());
 
     // Find among their neighbors the vertex with the smallest "support" value
-    if (minSupportVertices.size() > 0) {
-        minSupport = SCORE_LIMIT;
-        for (auto &v : minSupportVertices) {
-            Vertex &vertex {this->vertices[v]};
-            for (auto &w : vertex.neighbors) {
-                Vertex &neighbor {this->vertices[w]};
-                support = 0;
-                for (auto &x : neighbor.neighbors) {
-                    support += this->vertices[x].degree;
-                }
-                if (support < minSupport) {
-                    candidate = w;
-                    minSupport = support;
-                }
+    for (auto &v : this->minSupportVertices) {
+        for (auto &w : this->getNeighbors(v)) {
+            if (this->supports[w] < minSupport) {
+                candidate = w;
+                minSupport = this->supports[w];
             }
         }
     }
@@ -315,6 +744,7 @@ vid Graph::getMinSupportVertexNeighbor()
 void Graph::constructMIS(vidSet &set)
 {
     set.clear();
+    set.reserve(this->vertices.size());
     for (auto &vertex : this->vertices) {
         if (vertex.isEnabled()) {
             set.insert(vertex.id);
@@ -322,153 +752,395 @@ void Graph::constructMIS(vidSet &set)
     }
 }
 
-vid Graph::getVertexOfDegree(score d)
+/**
+ *  Copy the subgraph induced by some vertices into another graph (vertex i of the new graph is vertices[i])
+ */
+Graph Graph::extractSubgraph(const vector<vid> &members)
 {
-    for (auto &vertex : this->vertices) {
-        if (vertex.degree == d) {
-            return vertex.id;
+    Graph sub(members.size());
+    vector<vidPair> edges;
+    sub.matrixThreshold = this->matrixThreshold;
+    sub.table = this->table;
+    sub.tableThreshold = this->tableThreshold;
+    sub.hasDeadline = this->hasDeadline;
+    sub.deadline = this->deadline;
+    for (vid i = 0; i < members.size(); ++i) {
+        this->componentIndex[members[i]] = i;
+    }
+    for (vid i = 0; i < members.size(); ++i) {
+        for (auto &w : this->getNeighbors(members[i])) {
+            if (this->componentIndex[w] > i) {
+                edges.push_back(make_pair(i, this->componentIndex[w]));
+            }
         }
     }
-    return NO_VERTEX_FOUND;
+    sub.buildAdjacency(edges);
+    return sub;
 }
 
 /**
- *  A vertex with a degree of 1 is always part of a MIS.
- *  If such vertices are found, they are processed directly
- *  and the result is returned to the calling method.
+ *  Once vertices have been disabled, the remaining graph often falls apart into several connected components.
+ *  A MIS is then the union of a MIS of each component (plus the isolated vertices), so each component is solved
+ *  on its own: the size of the search tree becomes a sum instead of a product. Large components are solved in
+ *  separate threads. The components are solved by the exact search alone (see runExactMIS()): they were reduced with
+ *  the rest of the graph, and instead of a MIS found by heuristics, each of them starts from a bound derived from the
+ *  MIS of the whole graph. Returns false if the remaining graph is connected (nothing was done).
  */
-cardinal Graph::processObviousVertex(vector<Vertex> &backup)
-{
-    vid candidate;
-    while ((candidate = this->getVertexOfDegree(1)) != NO_VERTEX_FOUND) {
-        Vertex &neighbor {this->getNeighborByIndex(candidate, 0)};
-        backup.push_back(neighbor);
-        this->disableVertex(neighbor.id);
-        if (this->isIndependent()) {
-            if (this->enabledCardinal > this->MIS.size()) {
-                this->constructMIS(this->MIS);
+bool Graph::findComponentsMIS(cardinal &result)
+{
+    static atomic<unsigned> componentThreads {0};
+    cardinal n {this->vertices.size()}, remaining {0}, isolated {0};
+    vid start {NO_VERTEX_FOUND};
+
+    for (auto &vertex : this->vertices) {
+        if (!vertex.enabled) continue;
+        if (vertex.degree == 0) {
+            ++isolated;
+        } else {
+            ++remaining;
+            if (start == NO_VERTEX_FOUND) start = vertex.id;
+        }
+    }
+
+    // Breadth-first search from the first vertex: if it reaches every vertex, the graph is connected
+    // (componentIndex is only reset for the vertices that were reached, so that this test stays cheap)
+    vector<vid> &queue {this->componentQueue};
+    if (this->componentIndex.size() != n) this->componentIndex.assign(n, NO_VERTEX_FOUND);
+    queue.clear();
+    queue.push_back(start);
+    this->componentIndex[start] = 0;
+    for (cardinal i = 0; i < queue.size(); ++i) {
+        for (auto &w : this->getNeighbors(queue[i])) {
+            if (this->componentIndex[w] == NO_VERTEX_FOUND) {
+                this->componentIndex[w] = 0;
+                queue.push_back(w);
             }
-            for (auto &vertex : backup) {
-                this->restoreVertex(vertex);
+        }
+    }
+    if (queue.size() == remaining) {
+        for (vid v : queue) this->componentIndex[v] = NO_VERTEX_FOUND;
+        return false;
+    }
+
+    vector<vector<vid>> components(1, queue);
+    for (auto &vertex : this->vertices) {
+        if (!vertex.enabled || vertex.degree == 0 || this->componentIndex[vertex.id] != NO_VERTEX_FOUND) continue;
+        vid c {(vid) components.size()};
+        components.push_back(vector<vid>(1, vertex.id));
+        this->componentIndex[vertex.id] = c;
+        for (cardinal i = 0; i < components[c].size(); ++i) {
+            for (auto &w : this->getNeighbors(components[c][i])) {
+                if (this->componentIndex[w] == NO_VERTEX_FOUND) {
+                    this->componentIndex[w] = c;
+                    components[c].push_back(w);
+                }
             }
-            return this->enabledCardinal - 1;
+        }
+    }
+
+    // The cover was just built (see findExactMIS()), and a clique is named after one of its vertices:
+    // the cliques of each component bound its MIS
+    vector<cardinal> bounds(components.size(), 0);
+    cardinal total {isolated};
+    for (cardinal c = 0; c < components.size(); ++c) {
+        for (vid v : components[c]) {
+            if (this->cliqueOf[v] == v) ++bounds[c];
+        }
+        total += bounds[c];
+    }
+
+    vector<Graph> subgraphs;
+    vector<cardinal> targets(components.size(), 0);
+    vector<bool> solved(components.size(), false);
+    vector<future<void>> threads(components.size());
+    subgraphs.reserve(components.size()); // the threads keep pointers to the subgraphs
+    for (auto &component : components) {
+        subgraphs.push_back(this->extractSubgraph(component));
+    }
+    for (auto &component : components) {
+        for (vid v : component) this->componentIndex[v] = NO_VERTEX_FOUND;
+    }
+
+    // A component only has to beat the MIS minus the bounds of the other components (which get tighter as they are
+    // solved); as soon as the bounds add up to the MIS, the other components are not solved at all
+    auto update = [&](cardinal c) {
+        Graph &sub {subgraphs[c]};
+        cardinal bound {max(targets[c], sub.getUpperBound())};
+        total -= bounds[c];
+        bounds[c] = min(bounds[c], bound);
+        total += bounds[c];
+        this->numberOfCalls += sub.numberOfCalls;
+        this->numberOfCuts += sub.numberOfCuts;
+        this->numberOfTableHits += sub.numberOfTableHits;
+        this->numberOfTableMisses += sub.numberOfTableMisses;
+        if (sub.stopped) this->stopped = true;
+    };
+    for (cardinal c = 0; c < components.size() && total > this->lowerBound && !this->stopped; ++c) {
+        Graph &sub {subgraphs[c]};
+        targets[c] = (this->lowerBound > total - bounds[c]) ? this->lowerBound - (total - bounds[c]) : 0;
+        solved[c] = true;
+        if (components[c].size() >= PARALLEL_COMPONENT_SIZE
+            && componentThreads.fetch_add(1) < thread::hardware_concurrency()) {
+            threads[c] = async(launch::async, [&sub, &targets, c]() {
+                Reducer reducer(sub, false);
+                sub.runExactMIS(reducer, targets[c]);
+                --componentThreads;
+            });
         } else {
-            return BAD_MIS;
+            if (components[c].size() >= PARALLEL_COMPONENT_SIZE) --componentThreads;
+            Reducer reducer(sub, false);
+            sub.runExactMIS(reducer, targets[c]);
+            update(c);
+        }
+    }
+
+    bool complete {true};
+    result = isolated;
+    for (cardinal c = 0; c < components.size(); ++c) {
+        if (threads[c].valid()) {
+            threads[c].get();
+            update(c);
         }
+        if (solved[c] && subgraphs[c].MIS.size() > targets[c]) {
+            result += subgraphs[c].MIS.size();
+        } else {
+            complete = false;
+        }
+    }
+    if (this->stopped) {
+        this->abandonBranch(total);
+    }
+
+    if (complete && result > this->lowerBound) {
+        this->MIS.clear();
+        for (auto &vertex : this->vertices) {
+            if (vertex.enabled && vertex.degree == 0) this->MIS.insert(vertex.id);
+        }
+        for (cardinal c = 0; c < components.size(); ++c) {
+            for (vid v : subgraphs[c].MIS) this->MIS.insert(components[c][v]);
+        }
+        this->lowerBound = this->MIS.size();
+    } else {
+        result = BAD_MIS;
     }
-    return BAD_MIS;
+    return true;
 }
 
 /**
- *  A vertex with a degree of 2, whose neighbors are connected to each other,
- *  is always part of a MIS. The same can be observed with a pair of vertices with a degree of 2,
- *  who share the same neighbors. If such vertices are found, they are processed directly
- *  and the result is returned to the calling method.
+ *  The vertices that are neither disabled nor isolated are copied into a SmallMIS (their IDs are stored temporarily
+ *  in componentIndex), which finishes the search. Returns the cardinality of the MIS, or BAD_MIS if it was not better.
+ *  Kernels of up to tableThreshold vertices are looked up in the transposition table first, with the hash of their
+ *  edges: a MIS found for the same kernel in another branch (often as a component, see findComponentsMIS()) is used
+ *  once it was checked against the kernel (two kernels could have the same hashes), and a bound that cannot beat the
+ *  target cuts the branch. Unless the search was stopped, its result is stored.
  */
-vidPair Graph::getTwinVertices()
+template <unsigned Words>
+cardinal Graph::findSmallMIS()
 {
+    vector<vid> &members {this->componentQueue};
+    cardinal isolated {0};
+    if (this->componentIndex.size() != this->vertices.size()) {
+        this->componentIndex.assign(this->vertices.size(), NO_VERTEX_FOUND);
+    }
+    members.clear();
     for (auto &vertex : this->vertices) {
-        if (vertex.degree == 2) {
-            Vertex &n1 {this->getNeighborByIndex(vertex.id, 0)}, &n2 {this->getNeighborByIndex(vertex.id, 1)};
-            if (n1.isConnectedTo(n2.id)) {
-                return make_pair(n1.id, n2.id); // the neighbors are connected to each other
-            } else {
-                for (auto &w : n1.neighbors) {
-                    if (this->vertices[w].degree == 2 && w != vertex.id && this->vertices[w].isConnectedTo(n2.id)) {
-                        return make_pair(n1.id, n2.id); // 2 vertices with a degree of 2 share the same neighbors
-                    }
-                }
-            }
+        if (!vertex.enabled) continue;
+        if (vertex.degree == 0) {
+            ++isolated;
+        } else {
+            this->componentIndex[vertex.id] = (vid) members.size();
+            members.push_back(vertex.id);
         }
     }
-    return make_pair(NO_VERTEX_FOUND, NO_VERTEX_FOUND);
-}
 
-cardinal Graph::processTwinVertices(vector<Vertex> &backup)
-{
-    vidPair candidates, notFound(NO_VERTEX_FOUND, NO_VERTEX_FOUND);
-    while ((candidates = this->getTwinVertices()) != notFound) {
-        backup.push_back(this->vertices[candidates.first]);
-        backup.push_back(this->vertices[candidates.second]);
-        this->disableVertex(candidates.first);
-        this->disableVertex(candidates.second);
-        if (this->isIndependent()) {
-            if (this->enabledCardinal > this->MIS.size()) {
-                this->constructMIS(this->MIS);
-            }
-            for (auto &vertex : backup) {
-                this->restoreVertex(vertex);
+    SmallMIS<Words> small(members.size());
+    bool cached {this->table != nullptr && members.size() <= this->tableThreshold};
+    hashKey key {hashEdge((vid) members.size(), NO_VERTEX_FOUND)}, check {key};
+    for (vid i = 0; i < members.size(); ++i) {
+        for (auto &w : this->getNeighbors(members[i])) {
+            vid j {this->componentIndex[w]};
+            small.addNeighbor(i, j);
+            if (cached && i < j) {
+                hashKey h {hashEdge(i, j)};
+                key ^= h;
+                check += h;
             }
-            return this->enabledCardinal - 2;
-        } else {
+        }
+    }
+    for (vid v : members) {
+        this->componentIndex[v] = NO_VERTEX_FOUND;
+    }
+
+    // The isolated vertices may already outnumber the MIS: then any independent set of the kernel beats it
+    cardinal target {(this->lowerBound > isolated) ? this->lowerBound - isolated : 0};
+    tableResult result;
+    if (cached && this->table->lookup(key, check, result)
+        && (result.exact ? small.isIndependentSet(result.selected, TABLE_WORDS, result.bound) : result.bound <= target)) {
+        ++this->numberOfTableHits;
+        if (result.bound <= target) {
             return BAD_MIS;
         }
+    } else {
+        if (cached) ++this->numberOfTableMisses;
+        if (this->hasDeadline) {
+            small.setDeadline(this->deadline);
+        }
+        bool found {small.solve(target)};
+        this->numberOfCalls += small.getNumberOfCalls();
+        this->numberOfCuts += small.getNumberOfCuts();
+        if (small.isStopped()) {
+            this->stopped = true;
+            this->abandonBranch(isolated + small.getUpperBound());
+        }
+
+        // Unless the search was stopped, it found the MIS of the kernel, or proved that none is larger than the target
+        result.exact = found;
+        result.bound = found ? small.getUpperBound() : target;
+        memset(result.selected, 0, sizeof(result.selected));
+        for (vid i = 0; i < members.size() && found && cached; ++i) {
+            if (small.isSelected(i)) result.selected[i / WORD_BITS] |= (word) 1 << (i % WORD_BITS);
+        }
+        if (cached && !small.isStopped()) {
+            this->table->store(key, check, result);
+        }
+        if (!found) {
+            return BAD_MIS;
+        }
+    }
+
+    this->MIS.clear();
+    for (auto &vertex : this->vertices) {
+        if (vertex.enabled && vertex.degree == 0) this->MIS.insert(vertex.id);
+    }
+    for (vid i = 0; i < members.size(); ++i) {
+        if (cached ? (result.selected[i / WORD_BITS] >> (i % WORD_BITS)) & 1 : small.isSelected(i)) {
+            this->MIS.insert(members[i]);
+        }
     }
-    return BAD_MIS;
+    this->lowerBound = this->MIS.size();
+    return this->lowerBound;
 }
 
 /**
- *  Vertices with a degree of 1 or 2 are processed first (see previous methods).
+ *  The reductions are applied first (see Reducer), to the vertices around the ones removed by the previous branch.
  *  Next, c1 <= c2 is always true, so even if a MIS with a cardinality of c2 is found,
- *  we MUST check g because it might contain a larger MIS. That is why g is checked before copy,
- *  even if the latter is faster to check.
+ *  we MUST check the first branch because it might contain a larger MIS.
+ *  Both branches are cut if the clique cover (see coverWithCliques()) shows that they cannot contain a larger MIS.
+ *  Once few vertices remain, and the cover could not cut the branch, the search is finished on fixed-width bitsets
+ *  (see findSmallMIS()). If the remaining graph is disconnected, we do not branch at all (see findComponentsMIS()).
+ *
+ *  Every removal is recorded in the trail, and undone by rolling back to a mark: the graph is never copied,
+ *  and the memory that is used grows with the depth of the search, not with the size of the graph.
+ *
+ *  Once the deadline has passed, the branches that are left are abandoned, and their upper bounds are kept:
+ *  the largest one bounds the cardinality of a MIS (see getUpperBound()).
+ *  Returns the cardinality of the largest MIS found in this branch (BAD_MIS if it is not better than the known one).
  */
-cardinal Graph::findExactMIS()
-{
-    static unsigned long long x {0};
-    vector<Vertex> backup0;
-    cardinal c0 {0};
-    if ((c0 = this->processObviousVertex(backup0)) != BAD_MIS) {
-        return c0;
-    } else if ((c0 = this->processTwinVertices(backup0)) != BAD_MIS) {
-        return c0;
-    }
-
-    vid candidate {this->getMaxDegreeVertex()};
-    cardinal c1 {this->enabledCardinal - 1}, c2 {(this->enabledCardinal - this->vertices[candidate].degree)};
-
-    if (c1 > this->MIS.size()) {
-        Vertex backup1(this->vertices[candidate]); // keep a copy of the vertex
-        this->disableVertex(candidate); // disable the vertex with the highest degree
-        if (!this->isIndependent()) { // terminal condition
-            c1 = this->findExactMIS();
-        } else if (this->enabledCardinal > this->MIS.size()) {
+cardinal Graph::findExactMIS(Reducer &reducer)
+{
+    cardinal mark {this->getTrailMark()}, c1 {0}, c2 {0};
+    ++this->numberOfCalls;
+
+    reducer.reduce();
+
+    if (this->isIndependent()) { // terminal condition
+        if (this->enabledCardinal > this->lowerBound) {
             this->constructMIS(this->MIS);
+            this->lowerBound = this->MIS.size();
+            c1 = this->enabledCardinal;
         }
-        this->restoreVertex(backup1); // restore the disabled vertex
+    } else if (this->numberOfCliques <= this->lowerBound) {
+        ++this->numberOfCuts; // the inherited cover is enough
     } else {
-        c1 = 0;
-    }
+        cardinal coverMark {this->coverTrail.size()}, cliques {this->numberOfCliques};
+        this->coverWithCliques();
+
+        if (this->numberOfCliques <= this->lowerBound) {
+            ++this->numberOfCuts;
+        } else if (this->isPastDeadline()) {
+            this->abandonBranch(this->numberOfCliques);
+        } else if (this->kernelCardinal <= SMALL_GRAPH_SIZE) {
+            static_assert(SMALL_GRAPH_SIZE <= SmallMIS<2>::CAPACITY, "small subgraphs must fit in 2 words per row");
+            if (this->kernelCardinal <= SmallMIS<1>::CAPACITY) {
+                c1 = this->findSmallMIS<1>();
+            } else {
+                c1 = this->findSmallMIS<2>();
+            }
+        } else if (this->findComponentsMIS(c1)) {
+            // the remaining graph is disconnected, its components were solved separately
+        } else {
+            vid candidate {this->getMaxDegreeVertex()};
+            cardinal branchMark {this->getTrailMark()};
+            c1 = this->enabledCardinal - 1;
+            c2 = this->enabledCardinal - this->vertices[candidate].degree;
+
+            if (c1 > this->lowerBound) {
+                reducer.excludeVertex(candidate); // disable the vertex with the highest degree
+                c1 = this->findExactMIS(reducer);
+                this->rollback(branchMark);
+            } else {
+                c1 = 0;
+            }
 
-    if (c2 > this->MIS.size() && c2 > c1) {
-        Graph copy(*this);
-        copy.disableVertexNeighborhood(candidate); // keep the vertex with the highest degree
-        if (!copy.isIndependent()) { // terminal condition
-            c2 = copy.findExactMIS();
-            if (copy.MIS.size() > this->MIS.size()) {
-                this->MIS = copy.MIS;
+            if (c2 > this->lowerBound && this->stopped) {
+                this->abandonBranch(min(c2, this->numberOfCliques));
+                c2 = 0;
+            } else if (c2 > this->lowerBound) {
+                reducer.includeVertex(candidate); // keep the vertex with the highest degree
+                c2 = this->findExactMIS(reducer);
+                this->rollback(branchMark);
+            } else {
+                c2 = 0;
             }
-        } else if (copy.enabledCardinal > this->MIS.size()) {
-            copy.constructMIS(this->MIS);
         }
-    } else {
-        c2 = 0;
+
+        // The previous cover must be restored before the removals that came before it are undone
+        this->restoreCover(coverMark);
+        this->numberOfCliques = cliques;
     }
 
-    this->numberOfCalls = ++x;
-    for (auto &vertex : backup0) this->restoreVertex(vertex);
+    this->rollback(mark);
     return ((c1 | c2) == 0) ? BAD_MIS : ((c1 > c2) ? c1 : c2);
 }
 
 /**
- *  ALGO_BEST: run the best heuristics in parallel (rudimentary multithreading) and return the best result.
+ *  The reducer only examines the vertices it was given (see Reducer::enqueueAll()): the components of a graph that was
+ *  already reduced do not need to be examined again. Returns the cardinality of the MIS found (BAD_MIS if none was
+ *  larger than the bound).
+ */
+cardinal Graph::runExactMIS(Reducer &reducer, cardinal bound)
+{
+    cardinal result;
+    this->numberOfCalls = 0;
+    this->numberOfCuts = 0;
+    this->numberOfTableHits = 0;
+    this->numberOfTableMisses = 0;
+    this->trail.reserve(2 * this->numberOfEdges + this->vertices.size());
+    this->initializeCover();
+    this->lowerBound = bound;
+    this->stopped = false;
+    this->openBound = 0;
+    this->deadlineCountdown = 0;
+    this->recordTrail = true;
+    result = this->findExactMIS(reducer);
+    this->recordTrail = false;
+    return result;
+}
+
+/**
+ *  ALGO_BEST: run the best heuristics in parallel (rudimentary multithreading), and improve the best result with a
+ *  local search (see LocalSearch).
+ *
+ *  ALGO_PORTFOLIO: restart randomized heuristics on several threads, until the time is up (see findPortfolioMIS()).
  *
  *  ALGO_EXACT: find a large MIS fast, thanks to heuristics; ignore candidates with a smaller cardinality
  *  when searching for a MIS (that is actually maximum, with a 100% certainty).
  *
+ *  ALGO_EXACT_BITSET: same as above, but the search is done on bitsets (see BitGraph), possibly with several threads.
+ *
  *  Heuristics: select a vertex and disable it; rince and repeat until no edges remain (we get a MIS).
  */
-vidSet Graph::findMIS(algorithm algo)
+vidSet Graph::findKernelMIS(algorithm algo)
 {
     vidSet set;
     if (this->isIndependent()) {
@@ -479,27 +1151,48 @@ vidSet Graph::findMIS(algorithm algo)
         vector<vidSet> sets;
         vector<future<vidSet>> threads;
         for (auto heuristic : {ALGO_MVSA, ALGO_MDG, ALGO_VSA}) {
-            threads.push_back(async(&Graph::findMIS, this, heuristic));
+            threads.push_back(async(&Graph::findKernelMIS, this, heuristic));
         }
         for (auto &thread : threads) {
             sets.push_back(thread.get());
         }
-        sort(sets.begin(), sets.end(), [](vidSet a, vidSet b) { return a.size() > b.size(); });
-        set = *(sets.begin()); // pointer to the largest MIS
+        sort(sets.begin(), sets.end(), [](const vidSet &a, const vidSet &b) { return a.size() > b.size(); });
+        set = this->improveMIS(*(sets.begin())); // the largest MIS is a good starting point for the local search
     } else if (algo == ALGO_EXACT) {
         if (this->MIS.size() == 0) {
-            this->findMIS(ALGO_MVSA);
-            this->findMIS(ALGO_MDG);
+            this->findKernelMIS(ALGO_MVSA);
+            this->findKernelMIS(ALGO_MDG);
+            this->MIS = this->improveMIS(this->MIS);
+        }
+        Reducer reducer(*this, false);
+        reducer.enqueueAll();
+        TranspositionTable table(min(this->tableSize, this->vertices.size() * TABLE_SIZE_PER_VERTEX));
+        this->table = table.isEnabled() ? &table : nullptr;
+        this->runExactMIS(reducer, this->MIS.size());
+        this->table = nullptr;
+    } else if (algo == ALGO_EXACT_BITSET) {
+        if (this->MIS.size() == 0) {
+            this->findKernelMIS(ALGO_MVSA);
+            this->findKernelMIS(ALGO_MDG);
+            this->MIS = this->improveMIS(this->MIS);
+        }
+        BitGraph b(*this);
+        if (this->hasDeadline) b.setDeadline(this->deadline);
+        set = b.findMIS(this->MIS, this->numberOfThreads);
+        this->numberOfCalls = b.getNumberOfCalls();
+        this->stopped = b.isStopped();
+        this->openBound = b.getUpperBound();
+        if (this->stopped) { // the bounds of the bitset version are weak, a clique cover of the whole graph may be better
+            this->initializeCover();
+            this->coverWithCliques();
+            this->openBound = min(this->openBound, max(this->numberOfCliques, this->MIS.size()));
+            this->coverTrail.clear();
         }
-        this->findExactMIS();
+    } else if (algo == ALGO_PORTFOLIO) {
+        set = this->findPortfolioMIS();
     } else {
         Graph g(*this);
-        switch (algo) {
-            case ALGO_MDG:  while (!g.isIndependent()) g.disableVertex(g.getMaxDegreeVertex()); break;
-            case ALGO_VSA:  while (!g.isIndependent()) g.disableVertex(g.getMaxSupportVertex()); break;
-            case ALGO_MVSA: while (!g.isIndependent()) g.disableVertex(g.getMinSupportVertexNeighbor()); break;
-            default: throw std::invalid_argument("Invalid algorithm"); break;
-        }
+        g.runHeuristic(algo);
         g.constructMIS(set);
     }
 
@@ -509,16 +1202,337 @@ vidSet Graph::findMIS(algorithm algo)
     return (set.size() > 0) ? set : this->MIS;
 }
 
-bool Graph::checkMIS(const vidSet &MIS)
+/**
+ *  All algorithms work on the graph as it was left by the reductions (see Reducer), if any were applied.
+ */
+vidSet Graph::findMIS(algorithm algo)
 {
-    for (vid v : MIS) {
-        for (vid w : MIS) {
-            if (v < w && this->areVerticesConnected(v, w)) {
-                return false;
+    return this->restoreIDs(this->liftMIS(this->findKernelMIS(algo)));
+}
+
+/**
+ *  Folds are undone in reverse order: if u is part of the MIS, so is w, otherwise v is.
+ */
+vidSet Graph::liftMIS(vidSet set)
+{
+    for (auto it = this->folds.crbegin(); it != this->folds.crend(); ++it) {
+        set.insert((set.count(it->u) != 0) ? it->w : it->v);
+    }
+    return set;
+}
+
+/**
+ *  The graph is copied in the new order (see copyPermuted()), and the original ID of each vertex is kept, so that the
+ *  sets returned by findMIS() use the IDs of the file. Folds use the new IDs, so nothing may be reduced before.
+ */
+void Graph::relabel(ordering o)
+{
+    if (o == ORDER_NONE) return;
+    Ordering relabeling(*this, o);
+    const vector<vid> &order {relabeling.getOrder()};
+    Graph source(*this);
+    this->copyPermuted(source, order);
+    this->originalID.resize(order.size());
+    for (vid p = 0; p < order.size(); ++p) {
+        this->originalID[p] = source.originalID.empty() ? order[p] : source.originalID[order[p]];
+    }
+    this->indexAdjacency();
+}
+
+vidSet Graph::restoreIDs(const vidSet &set)
+{
+    if (this->originalID.empty()) return set;
+    vidSet original;
+    for (vid v : set) {
+        original.insert(this->originalID[v]);
+    }
+    return original;
+}
+
+// The heuristic runs on a copy (see findKernelMIS()), so the graph itself does not change
+double Graph::timeHeuristic(algorithm algo)
+{
+    Graph g(*this);
+    Timer t;
+    g.runHeuristic(algo);
+    return t.countMilliseconds();
+}
+
+// Unlike findMIS(), no copy and no reduction: the graph itself loses its edges, and the IDs are those of the graph
+vidSet Graph::findHeuristicMIS(algorithm algo)
+{
+    vidSet set;
+    this->runHeuristic(algo);
+    this->constructMIS(set);
+    return set;
+}
+
+void Graph::runHeuristic(algorithm algo)
+{
+    switch (algo) {
+        case ALGO_MDG:  while (!this->isIndependent()) this->disableVertex(this->getMaxDegreeVertex()); break;
+        case ALGO_VSA:
+            this->initializeSupports(algo);
+            while (!this->isIndependent()) this->disableVertex(this->getMaxSupportVertex());
+            break;
+        case ALGO_MVSA:
+            this->initializeSupports(algo);
+            while (!this->isIndependent()) this->disableVertex(this->getMinSupportVertexNeighbor());
+            break;
+        default: throw std::invalid_argument("Invalid algorithm"); break;
+    }
+}
+
+/**
+ *  Vertex p of this graph is vertex order[p] of the other graph. The memory of the previous copy is reused.
+ *  Only what the heuristics need is copied.
+ */
+void Graph::copyPermuted(const Graph &g, const vector<vid> &order)
+{
+    cardinal n {g.vertices.size()};
+    this->componentIndex.resize(n); // scratch: position of each vertex of g in this graph
+    for (vid p = 0; p < n; ++p) {
+        this->componentIndex[order[p]] = p;
+    }
+    this->vertices.resize(n);
+    this->adjacency.clear();
+    this->unusedEntries = 0;
+    for (vid p = 0; p < n; ++p) {
+        const Vertex &source {g.vertices[order[p]]};
+        Vertex &vertex {this->vertices[p]};
+        vertex.id = p;
+        vertex.enabled = source.enabled;
+        vertex.offset = this->adjacency.size();
+        vertex.degree = vertex.capacity = source.degree;
+        for (auto &w : g.getNeighbors(order[p])) {
+            this->adjacency.push_back(this->componentIndex[w]);
+        }
+    }
+    this->componentIndex.assign(n, NO_VERTEX_FOUND);
+    this->adjacencyIndex.reset(); // the heuristics do not need it
+    this->numberOfEdges = g.numberOfEdges;
+    this->enabledCardinal = g.enabledCardinal;
+    this->recordSupports = false;
+    this->initializeBuckets();
+}
+
+/**
+ *  Each thread restarts the heuristics (in turn) until the time is up, on its own copy of the graph, whose vertices are
+ *  numbered in a random order: the ties between vertices with the same degree (or support) are then broken differently
+ *  every time. Each result is improved by a local search, and each thread has its own random numbers (drawn from
+ *  the generator of the graph, so --seed makes the sequence of restarts reproducible).
+ *
+ *  The threads share the cardinality of the largest set found so far (an atomic variable, no lock): a thread only keeps
+ *  a set that beat it, so the largest set of all is the largest of the sets kept by the threads.
+ */
+vidSet Graph::findPortfolioMIS()
+{
+    atomic<cardinal> bestSize {this->MIS.size()};
+    atomic<unsigned long long> restarts {0};
+    timePoint end {Time::now() + chrono::duration_cast<Time::duration>(seconds(this->portfolioSeconds))};
+    vector<vidSet> sets(this->portfolioThreads);
+    vector<thread> threads;
+    for (unsigned t = 0; t < this->portfolioThreads; ++t) {
+        unsigned seed {(unsigned) this->rng()};
+        threads.push_back(thread([this, t, seed, end, &bestSize, &restarts, &sets]() {
+            const algorithm heuristics[] {ALGO_MVSA, ALGO_MDG, ALGO_VSA};
+            mt19937 rng(seed);
+            Graph scratch;
+            LocalSearch search(*this);
+            vector<vid> order(this->vertices.size());
+            vidSet set;
+            for (vid v = 0; v < order.size(); ++v) {
+                order[v] = v;
+            }
+
+            for (unsigned long long r = t; Time::now() < end; ++r) {
+                shuffle(order.begin(), order.end(), rng);
+                scratch.copyPermuted(*this, order);
+                scratch.runHeuristic(heuristics[r % 3]);
+                set.clear();
+                for (auto &vertex : scratch.vertices) {
+                    if (vertex.enabled) set.insert(order[vertex.id]);
+                }
+
+                double left {chrono::duration_cast<seconds>(end - Time::now()).count()};
+                if (this->searchSeconds > 0.0 && this->searchSeconds < left) left = this->searchSeconds;
+                if ((this->searchIterations > 0 || this->searchSeconds > 0.0) && left > 0.0) {
+                    search.setBudget(this->searchIterations, left);
+                    search.setSeed(rng());
+                    set = search.improve(set);
+                }
+                ++restarts;
+
+                cardinal size {set.size()}, best {bestSize.load()};
+                while (size > best && !bestSize.compare_exchange_weak(best, size)) {}
+                if (size > best) sets[t] = set;
+            }
+        }));
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    this->numberOfRestarts = restarts;
+    vidSet set;
+    for (auto &s : sets) {
+        if (s.size() > set.size()) set = s;
+    }
+    return set;
+}
+
+vidSet Graph::improveMIS(const vidSet &set)
+{
+    if (this->searchIterations == 0 && this->searchSeconds <= 0.0) return set;
+    LocalSearch search(*this);
+    search.setBudget(this->searchIterations, this->searchSeconds);
+    search.setSeed(this->seed);
+    return search.improve(set);
+}
+
+void Graph::setLocalSearch(unsigned long long iterations, double seconds)
+{
+    this->searchIterations = iterations;
+    this->searchSeconds = (seconds > 0.0) ? seconds : 0.0;
+}
+
+void Graph::setPortfolio(unsigned threads, double seconds)
+{
+    this->portfolioThreads = (threads > 0) ? threads : 1;
+    this->portfolioSeconds = (seconds > 0.0) ? seconds : DEFAULT_PORTFOLIO_TIME;
+}
+
+void Graph::setTable(size_t size, cardinal threshold)
+{
+    this->tableSize = size;
+    this->tableThreshold = (threshold < MAX_TABLE_THRESHOLD) ? threshold : MAX_TABLE_THRESHOLD;
+}
+
+void Graph::setDeadline(double seconds)
+{
+    this->hasDeadline = (seconds > 0.0);
+    if (this->hasDeadline) {
+        this->deadline = Time::now() + chrono::duration_cast<Time::duration>(chrono::duration<double>(seconds));
+    }
+}
+
+// The clock is only read every few branches: reading it costs more than most branches do
+bool Graph::isPastDeadline()
+{
+    if (this->hasDeadline && !this->stopped && this->deadlineCountdown-- == 0) {
+        this->deadlineCountdown = DEADLINE_CHECK_INTERVAL;
+        this->stopped = (Time::now() >= this->deadline);
+    }
+    return this->stopped;
+}
+
+/**
+ *  If the exact algorithm went to the end, the MIS it found is a maximum. Otherwise, a larger MIS can only be found
+ *  in the branches that were abandoned. Folded vertices are added, as they are by liftMIS().
+ */
+cardinal Graph::getUpperBound()
+{
+    cardinal bound {this->MIS.size()};
+    if (this->stopped && this->openBound > bound) {
+        bound = this->openBound;
+    }
+    return bound + this->folds.size();
+}
+
+cardinal Graph::getKernelSize()
+{
+    cardinal size {0};
+    for (auto &vertex : this->vertices) {
+        if (vertex.enabled && vertex.degree > 0) ++size;
+    }
+    return size;
+}
+
+/**
+ *  One walk over the rows, in O(n + m): a vertex of the set must have no neighbor in it (otherwise the set is not
+ *  independent), and a vertex out of it must have at least one (otherwise it could be added: the set is not maximal).
+ *  Large graphs are split into ranges of vertices, each of them checked by a thread.
+ */
+misCheck Graph::checkMIS(const vidSet &MIS)
+{
+    cardinal n {this->vertices.size()};
+    if (!MIS.empty() && *max_element(MIS.begin(), MIS.end()) >= n) return MIS_INVALID;
+    auto checkRange = [this, &MIS](vid first, vid last) {
+        misCheck result {MIS_MAXIMAL};
+        for (vid v = first; v < last; ++v) {
+            if (!this->vertices[v].enabled) continue;
+            bool selected {MIS.count(v) != 0}, covered {selected};
+            for (auto &w : this->getNeighbors(v)) {
+                if (MIS.count(w) != 0) {
+                    if (selected) return MIS_INVALID;
+                    covered = true;
+                    break;
+                }
             }
+            if (!covered) result = MIS_NOT_MAXIMAL;
         }
+        return result;
+    };
+
+    unsigned threads {(n >= PARALLEL_CHECK_SIZE) ? thread::hardware_concurrency() : 1};
+    if (threads <= 1) return checkRange(0, (vid) n);
+    vector<future<misCheck>> results;
+    for (unsigned t = 0; t < threads; ++t) {
+        results.push_back(async(launch::async, checkRange, (vid) (n * t / threads), (vid) (n * (t + 1) / threads)));
     }
-    return true;
+    misCheck result {MIS_MAXIMAL};
+    for (auto &r : results) {
+        result = min(result, r.get());
+    }
+    return result;
+}
+
+// Same layout as the file that GraphLoader maps (see SnapshotHeader)
+bool Graph::saveSnapshot(const vidSet &MIS, const char *path)
+{
+    vector<uint64_t> offsets {0};
+    vector<vid> rows, links;
+    rows.reserve(2 * this->numberOfEdges);
+    for (auto &vertex : this->vertices) {
+        for (auto &w : this->getNeighbors(vertex.id)) {
+            rows.push_back(w);
+        }
+        offsets.push_back(rows.size());
+    }
+    for (score degree = 1; degree < this->buckets.size(); ++degree) {
+        for (vid v = this->buckets[degree]; v != NO_VERTEX_FOUND; v = this->vertices[v].next) {
+            links.push_back(v);
+        }
+    }
+    vector<vid> members(MIS.begin(), MIS.end());
+
+    SnapshotHeader header;
+    memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+    header.version = SNAPSHOT_VERSION;
+    header.numberOfVertices = this->vertices.size();
+    header.numberOfEntries = rows.size();
+    header.numberOfLinks = links.size();
+    header.misSize = members.size();
+    vector<char> payload;
+    auto append = [&payload](const void *data, size_t size) {
+        payload.insert(payload.end(), static_cast<const char *>(data), static_cast<const char *>(data) + size);
+    };
+    append(offsets.data(), offsets.size() * sizeof(uint64_t));
+    append(rows.data(), rows.size() * sizeof(vid));
+    append(links.data(), links.size() * sizeof(vid));
+    append(members.data(), members.size() * sizeof(vid));
+    header.checksum = GraphLoader::checksum(payload.data(), payload.size());
+
+    ofstream file;
+    file.open(path, ios::out | ios::binary);
+    if (!file.is_open()) {
+        cerr << "Error while opening file " << path << endl;
+        return false;
+    }
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    file.write(payload.data(), payload.size());
+    file.close();
+    return !file.fail();
 }
 
 bool Graph::saveMIS(const vidSet &MIS, const char *path)
@@ -535,7 +1549,7 @@ bool Graph::saveMIS(const vidSet &MIS, const char *path)
         if (vertex.isIsolated()) {
             file << vertex.id + 1 << "\n";
         } else {
-            for (auto &w : vertex.neighbors) {
+            for (auto &w : this->getNeighbors(vertex.id)) {
                 if (w > vertex.id) {
                     file << vertex.id + 1 << " " << w + 1 << "\n";
                 }
@@ -0,0 +1,253 @@
+// Project: Maximum Independent Set (MIS, version 5)
+// Computer Science (2016-2017), 4th semester
+// Author: Guillaume Cocatre-Zilgien
+// Professor: Michel Ventou
+
+#include <algorithm>
+#include <cstring>
+#include <future>
+#include <limits>
+#include <thread>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "GraphLoader.hpp"
+#include "Timer.hpp"
+
+using namespace std;
+
+// Reads a number after some blanks (a vertex larger than 2^40 is out of range anyway)
+static bool parseNumber(const char *&p, const char *end, unsigned long &number)
+{
+    while (p < end && (*p == ' ' || *p == '\t')) ++p;
+    if (p == end || *p < '0' || *p > '9') return false;
+    number = 0;
+    for (; p < end && *p >= '0' && *p <= '9'; ++p) {
+        if (number < (1UL << 40)) number = number * 10 + (unsigned long) (*p - '0');
+    }
+    return true;
+}
+
+static const char * skipLine(const char *p, const char *end)
+{
+    const char *newline {static_cast<const char *>(memchr(p, '\n', end - p))};
+    return (newline != nullptr) ? newline + 1 : end;
+}
+
+GraphLoader::GraphLoader(const char *path, unsigned threads) : path {path}, mapping {nullptr}, n {0}, bytes {0},
+                                                               threads {1}, seconds {0.0}, opened {false},
+                                                               valid {true}, header {nullptr}
+{
+    Timer t;
+    int fd {open(path, O_RDONLY)};
+    if (fd < 0) return;
+    struct stat status;
+    if (fstat(fd, &status) != 0) {
+        close(fd);
+        return;
+    }
+    this->bytes = (size_t) status.st_size;
+    this->opened = true;
+    if (this->bytes == 0) {
+        close(fd);
+        return;
+    }
+    void *data {mmap(nullptr, this->bytes, PROT_READ, MAP_PRIVATE, fd, 0)};
+    close(fd);
+    if (data == MAP_FAILED) {
+        this->opened = false;
+        return;
+    }
+    const char *begin {static_cast<const char *>(data)}, *end {begin + this->bytes};
+    if (this->bytes >= sizeof(SnapshotHeader) && memcmp(begin, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) == 0) {
+        this->mapping = begin;
+        this->valid = this->parseSnapshot();
+        this->seconds = t.countSeconds();
+        return;
+    }
+    begin = this->parseHeader(begin, end);
+
+    // Chunks start after a newline, so every line belongs to exactly one of them
+    if (threads == 0) threads = thread::hardware_concurrency();
+    this->threads = (unsigned) max((size_t) 1, min((size_t) threads, (size_t) (end - begin) / MIN_CHUNK_SIZE));
+    vector<const char *> starts {begin};
+    for (unsigned c = 1; c < this->threads; ++c) {
+        const char *start {begin + (end - begin) * c / this->threads};
+        starts.push_back(max(starts.back(), skipLine(start, end)));
+    }
+    starts.push_back(end);
+    vector<vector<vidPair>> chunks(this->threads);
+    vector<char> stopped(this->threads, false);     // did the chunk contain the line of a MIS?
+    vector<char> parsed(this->threads, false);      // were all the vertices of the chunk in range?
+    vector<future<void>> results;
+    for (unsigned c = 0; c < this->threads; ++c) {
+        results.push_back(async(launch::async, [this, &starts, &chunks, &stopped, &parsed, c]() {
+            bool stop {false};
+            parsed[c] = this->parseChunk(starts[c], starts[c + 1], chunks[c], stop);
+            stopped[c] = stop;
+        }));
+    }
+    for (auto &result : results) {
+        result.get();
+    }
+    munmap(data, this->bytes);
+
+    // The chunks after the line of a MIS are not part of the graph
+    cardinal size {0}, last {0};
+    while (last < this->threads - 1 && !stopped[last]) ++last;
+    for (cardinal c = 0; c <= last; ++c) {
+        size += chunks[c].size();
+        if (!parsed[c]) this->valid = false;
+    }
+    if (last == 0) {
+        this->edges.swap(chunks[0]);
+    } else {
+        this->edges.reserve(size);
+        for (cardinal c = 0; c <= last; ++c) {
+            this->edges.insert(this->edges.end(), chunks[c].begin(), chunks[c].end());
+            vector<vidPair>().swap(chunks[c]);
+        }
+    }
+    this->seconds = t.countSeconds();
+}
+
+GraphLoader::~GraphLoader()
+{
+    if (this->mapping != nullptr) munmap(const_cast<char *>(this->mapping), this->bytes);
+}
+
+// Word by word (FNV-1a on 64-bit words, then the last bytes one at a time): it only has to catch damaged files
+uint64_t GraphLoader::checksum(const char *data, size_t size)
+{
+    const uint64_t prime {0x100000001b3ULL};
+    uint64_t hash {0xcbf29ce484222325ULL}, word;
+    size_t i {0};
+    for (; i + sizeof(word) <= size; i += sizeof(word)) {
+        memcpy(&word, data + i, sizeof(word));
+        hash = (hash ^ word) * prime;
+    }
+    for (; i < size; ++i) {
+        hash = (hash ^ (unsigned char) data[i]) * prime;
+    }
+    return hash;
+}
+
+/**
+ *  Nothing in a snapshot is trusted before it is checked: the arrays must fill the file exactly, the checksum must
+ *  match, the rows must follow each other, every vertex must be in range, and the vertices with neighbors must each be
+ *  listed once in the order of the buckets (Graph::loadSnapshot() moves them from bucket to bucket).
+ */
+bool GraphLoader::parseSnapshot()
+{
+    const SnapshotHeader *header {reinterpret_cast<const SnapshotHeader *>(this->mapping)};
+    uint64_t n {header->numberOfVertices};
+    size_t remaining {this->bytes - sizeof(SnapshotHeader)};
+    if (header->version != SNAPSHOT_VERSION || n >= numeric_limits<vid>::max()) return false;
+    if (n >= remaining / sizeof(uint64_t)) return false;
+    remaining -= (n + 1) * sizeof(uint64_t);
+    for (uint64_t count : {header->numberOfEntries, header->numberOfLinks}) {
+        if (count > remaining / sizeof(vid)) return false;
+        remaining -= count * sizeof(vid);
+    }
+    if (remaining != header->misSize * sizeof(vid)) return false;
+    if (checksum(this->mapping + sizeof(SnapshotHeader), this->bytes - sizeof(SnapshotHeader)) != header->checksum) {
+        return false;
+    }
+
+    this->header = header;
+    this->n = n;
+    const uint64_t *offsets {this->getOffsets()};
+    const vid *adjacency {this->getAdjacency()}, *links {this->getLinks()};
+    const vid *MIS {links + header->numberOfLinks};
+    bool valid {offsets[0] == 0 && offsets[n] == header->numberOfEntries};
+    cardinal linked {0};
+    for (vid v = 0; v < n && valid; ++v) {
+        if (offsets[v + 1] < offsets[v]) valid = false;
+        if (offsets[v + 1] > offsets[v]) ++linked;
+    }
+    for (uint64_t i = 0; i < header->numberOfEntries && valid; ++i) {
+        if (adjacency[i] >= n) valid = false;
+    }
+    vector<bool> seen(valid ? n : 0, false);
+    valid = valid && linked == header->numberOfLinks;
+    for (uint64_t i = 0; i < header->numberOfLinks && valid; ++i) {
+        vid v {links[i]};
+        if (v >= n || seen[v] || offsets[v + 1] == offsets[v]) {
+            valid = false;
+        } else {
+            seen[v] = true;
+        }
+    }
+    for (uint64_t i = 0; i < header->misSize && valid; ++i) {
+        if (MIS[i] >= n) {
+            valid = false;
+        } else {
+            this->storedMIS.insert(MIS[i]);
+        }
+    }
+    if (!valid) {
+        this->header = nullptr;
+        this->n = 0;
+        this->storedMIS.clear();
+    }
+    return valid;
+}
+
+const uint64_t * GraphLoader::getOffsets() const
+{
+    return reinterpret_cast<const uint64_t *>(this->mapping + sizeof(SnapshotHeader));
+}
+
+const vid * GraphLoader::getAdjacency() const
+{
+    return reinterpret_cast<const vid *>(this->getOffsets() + this->n + 1);
+}
+
+const vid * GraphLoader::getLinks() const
+{
+    return this->getAdjacency() + this->header->numberOfEntries;
+}
+
+double GraphLoader::getRate() const
+{
+    return (this->seconds > 0.0) ? this->bytes / 1e6 / this->seconds : 0.0;
+}
+
+// Same rules as the previous loader: comments, then "p edge N M", "p col N M" or "N"
+const char * GraphLoader::parseHeader(const char *p, const char *end)
+{
+    while (p < end && this->n == 0) {
+        const char *line {p};
+        unsigned long number;
+        p = skipLine(p, end);
+        while (line < p && (*line == ' ' || *line == '\t')) ++line;
+        if (line == p || *line == 'c') continue;
+        if (*line == 'M') return end;
+        if (*line == 'p') {
+            while (line < p && (*line < '0' || *line > '9') && *line != '\n') ++line;
+        }
+        if (parseNumber(line, p, number)) this->n = number;
+    }
+    return p;
+}
+
+bool GraphLoader::parseChunk(const char *p, const char *end, vector<vidPair> &chunk, bool &stopped) const
+{
+    chunk.reserve((end - p) / 12);              // about the length of a line
+    while (p < end) {
+        while (p < end && (*p == ' ' || *p == '\t')) ++p;
+        if (p < end && *p == 'M') {
+            stopped = true;
+            break;
+        }
+        if (p < end && *p == 'e') ++p;
+        unsigned long v, w;
+        if (parseNumber(p, end, v) && parseNumber(p, end, w)) {
+            if (v == 0 || w == 0 || v > this->n || w > this->n) return false;
+            chunk.push_back(make_pair((vid) (v - 1), (vid) (w - 1)));
+        }
+        p = skipLine(p, end);
+    }
+    return true;
+}
@@ -0,0 +1,242 @@
+// Project: Maximum Independent Set (MIS, version 5)
+// Computer Science (2016-2017), 4th semester
+// Author: Guillaume Cocatre-Zilgien
+// Professor: Michel Ventou
+
+#include "LocalSearch.hpp"
+
+using namespace std;
+
+const unsigned PERTURBATION_TRIES = 16;         // random picks before giving up on finding a vertex outside the solution
+
+LocalSearch::LocalSearch(Graph &g) : stamp {0}, recordMoves {false}, maxIterations {DEFAULT_SEARCH_ITERATIONS},
+                                     maxSeconds {0.0}, numberOfIterations {0}
+{
+    cardinal n {g.vertices.size()};
+    this->offsets.assign(n + 1, 0);
+    for (auto &vertex : g.vertices) {
+        this->offsets[vertex.id + 1] = this->offsets[vertex.id] + (vertex.enabled ? vertex.degree : 0);
+        if (vertex.enabled && vertex.degree > 0) this->kernel.push_back(vertex.id);
+    }
+    this->adjacency.reserve(this->offsets[n]);
+    for (auto &vertex : g.vertices) {
+        NeighborRange neighbors {g.getNeighbors(vertex.id)};
+        if (vertex.enabled) this->adjacency.insert(this->adjacency.end(), neighbors.begin(), neighbors.end());
+    }
+
+    this->inSolution.assign(n, false);
+    this->tightness.assign(n, 0);
+    this->solutionNeighbors.assign(n, 0);
+    this->position.assign(n, NO_VERTEX_FOUND);
+    this->queued.assign(n, false);
+    this->marks.assign(n, 0);
+    for (auto &vertex : g.vertices) {
+        if (vertex.enabled) this->addFree(vertex.id); // disabled vertices have no neighbors, and are never free
+    }
+}
+
+void LocalSearch::setBudget(unsigned long long iterations, double seconds)
+{
+    this->maxIterations = iterations;
+    this->maxSeconds = seconds;
+}
+
+// Without any budget, the initial set is only made maximal and improved with (1,2)-swaps
+bool LocalSearch::isOverBudget(Timer &t)
+{
+    if (this->maxIterations == 0 && this->maxSeconds <= 0.0) return true;
+    if (this->maxIterations > 0 && this->numberOfIterations >= this->maxIterations) return true;
+    return this->maxSeconds > 0.0 && this->numberOfIterations % SEARCH_CHECK_INTERVAL == 0
+        && t.countSeconds() >= this->maxSeconds;
+}
+
+void LocalSearch::enqueue(vid v)
+{
+    if (!this->queued[v]) {
+        this->queued[v] = true;
+        this->candidates.push_back(v);
+    }
+}
+
+// Free vertices and vertices of the solution are kept in lists, with the index of each vertex, so that they can be
+// removed in O(1) (the last vertex of the list takes its place)
+void LocalSearch::addFree(vid v)
+{
+    this->position[v] = this->freeVertices.size();
+    this->freeVertices.push_back(v);
+}
+
+void LocalSearch::removeFree(vid v)
+{
+    vid last {this->freeVertices.back()};
+    this->freeVertices[this->position[v]] = last;
+    this->position[last] = this->position[v];
+    this->freeVertices.pop_back();
+    this->position[v] = NO_VERTEX_FOUND;
+}
+
+void LocalSearch::insertVertex(vid v)
+{
+    if (this->position[v] != NO_VERTEX_FOUND) this->removeFree(v);
+    this->inSolution[v] = true;
+    this->position[v] = this->solution.size();
+    this->solution.push_back(v);
+    for (cardinal i = this->offsets[v]; i < this->offsets[v + 1]; ++i) {
+        vid w {this->adjacency[i]};
+        this->solutionNeighbors[w] ^= v;
+        if (this->tightness[w]++ == 0) {
+            this->removeFree(w);
+            this->enqueue(v); // w is now 1-tight, with v as its only neighbor in the solution
+        }
+    }
+    if (this->recordMoves) this->moves.push_back(make_pair(v, true));
+}
+
+void LocalSearch::removeVertex(vid v)
+{
+    vid last {this->solution.back()};
+    this->solution[this->position[v]] = last;
+    this->position[last] = this->position[v];
+    this->solution.pop_back();
+    this->inSolution[v] = false;
+    this->addFree(v); // its neighbors are not part of the solution
+    for (cardinal i = this->offsets[v]; i < this->offsets[v + 1]; ++i) {
+        vid w {this->adjacency[i]};
+        this->solutionNeighbors[w] ^= v;
+        if (--this->tightness[w] == 0) {
+            this->addFree(w);
+        } else if (this->tightness[w] == 1) {
+            this->enqueue(this->solutionNeighbors[w]); // w is now 1-tight
+        }
+    }
+    if (this->recordMoves) this->moves.push_back(make_pair(v, false));
+}
+
+void LocalSearch::insertFreeVertices()
+{
+    while (!this->freeVertices.empty()) {
+        this->insertVertex(this->freeVertices[this->rng() % this->freeVertices.size()]);
+    }
+}
+
+/**
+ *  The 1-tight neighbors of x are listed first; for each of them (u), its neighbors are marked, and any other 1-tight
+ *  neighbor of x that is not marked can be inserted along with u. That costs O(degree) for each 1-tight neighbor.
+ */
+bool LocalSearch::swapVertex(vid x)
+{
+    if (!this->inSolution[x]) return false;
+    this->oneTight.clear();
+    for (cardinal i = this->offsets[x]; i < this->offsets[x + 1]; ++i) {
+        if (this->tightness[this->adjacency[i]] == 1) this->oneTight.push_back(this->adjacency[i]);
+    }
+    if (this->oneTight.size() < 2) return false;
+
+    for (cardinal i = 0; i + 1 < this->oneTight.size(); ++i) {
+        vid u {this->oneTight[i]};
+        if (++this->stamp == 0) { // the stamp wrapped around: old marks must be erased
+            this->marks.assign(this->marks.size(), 0);
+            this->stamp = 1;
+        }
+        for (cardinal j = this->offsets[u]; j < this->offsets[u + 1]; ++j) {
+            this->marks[this->adjacency[j]] = this->stamp;
+        }
+        for (cardinal j = i + 1; j < this->oneTight.size(); ++j) {
+            vid w {this->oneTight[j]};
+            if (this->marks[w] != this->stamp) {
+                this->removeVertex(x);
+                this->insertVertex(u);
+                this->insertVertex(w);
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+void LocalSearch::descend()
+{
+    this->insertFreeVertices();
+    while (!this->candidates.empty()) {
+        vid x {this->candidates.back()};
+        this->candidates.pop_back();
+        this->queued[x] = false;
+        if (this->swapVertex(x)) this->insertFreeVertices();
+    }
+}
+
+// Usually one vertex is forced into the solution, sometimes two (ARW use the same kind of schedule)
+void LocalSearch::perturb()
+{
+    unsigned k {(this->rng() % 8 == 0) ? 2u : 1u};
+    for (unsigned i = 0; i < k; ++i) {
+        vid v {NO_VERTEX_FOUND};
+        for (unsigned t = 0; t < PERTURBATION_TRIES && v == NO_VERTEX_FOUND; ++t) {
+            vid w {this->kernel[this->rng() % this->kernel.size()]};
+            if (!this->inSolution[w]) v = w;
+        }
+        if (v == NO_VERTEX_FOUND) return;
+        for (cardinal j = this->offsets[v]; j < this->offsets[v + 1]; ++j) {
+            if (this->inSolution[this->adjacency[j]]) this->removeVertex(this->adjacency[j]);
+        }
+        this->insertVertex(v);
+    }
+}
+
+void LocalSearch::undo()
+{
+    this->recordMoves = false;
+    for (auto it = this->moves.crbegin(); it != this->moves.crend(); ++it) {
+        if (it->second) {
+            this->removeVertex(it->first);
+        } else {
+            this->insertVertex(it->first);
+        }
+    }
+    this->moves.clear();
+    this->recordMoves = true;
+    for (auto &v : this->candidates) {
+        this->queued[v] = false;
+    }
+    this->candidates.clear();
+}
+
+/**
+ *  The initial set is made maximal and improved with (1,2)-swaps; then every iteration perturbs the solution and
+ *  descends again, until the budget runs out. Only the largest solution found is copied.
+ *  The same search can improve several sets in a row: the previous solution is removed first.
+ */
+vidSet LocalSearch::improve(const vidSet &set)
+{
+    while (!this->solution.empty()) {
+        this->removeVertex(this->solution.back());
+    }
+    for (auto &v : this->candidates) {
+        this->queued[v] = false;
+    }
+    this->candidates.clear();
+    for (vid v : set) {
+        this->insertVertex(v);
+    }
+    this->descend();
+    this->best = this->solution;
+    this->numberOfIterations = 0;
+
+    Timer t;
+    this->recordMoves = true;
+    while (!this->kernel.empty() && !this->isOverBudget(t)) {
+        ++this->numberOfIterations;
+        cardinal size {this->solution.size()};
+        this->moves.clear();
+        this->perturb();
+        this->descend();
+        if (this->solution.size() < size) {
+            this->undo();
+        } else if (this->solution.size() > this->best.size()) {
+            this->best = this->solution;
+        }
+    }
+    this->recordMoves = false;
+
+    return vidSet(this->best.cbegin(), this->best.cend());
+}
@@ -0,0 +1,119 @@
+// Project: Maximum Independent Set (MIS, version 5)
+// Computer Science (2016-2017), 4th semester
+// Author: Guillaume Cocatre-Zilgien
+// Professor: Michel Ventou
+
+#include <algorithm>
+#include "Ordering.hpp"
+
+using namespace std;
+
+Ordering::Ordering(Graph &g, ordering o) : graph(g)
+{
+    switch (o) {
+        case ORDER_DEGENERACY: this->orderByDegeneracy(); break;
+        case ORDER_RCM:        this->orderByBFS(true);    break;
+        case ORDER_BFS:        this->orderByBFS(false);   break;
+        default:
+            this->order.resize(g.getSize());
+            for (vid v = 0; v < this->order.size(); ++v) {
+                this->order[v] = v;
+            }
+            break;
+    }
+}
+
+const char * Ordering::getName(ordering o)
+{
+    switch (o) {
+        case ORDER_DEGENERACY: return "degeneracy";
+        case ORDER_RCM:        return "rcm";
+        case ORDER_BFS:        return "bfs";
+        default:               return "none";
+    }
+}
+
+/**
+ *  Batagelj & Zaversnik: the vertices are sorted by degree in a single array, with the index of the first vertex of
+ *  each degree; removing the vertex at the front lowers the degree of its neighbors, which are moved to the front of
+ *  their part of the array. Runs in O(n + m).
+ */
+void Ordering::orderByDegeneracy()
+{
+    cardinal n {this->graph.getSize()};
+    vector<score> degree(n);
+    vector<cardinal> position(n), start;
+    score maxDegree {0};
+    for (vid v = 0; v < n; ++v) {
+        degree[v] = this->graph[v].getDegree();
+        maxDegree = max(maxDegree, degree[v]);
+    }
+
+    start.assign(maxDegree + 2, 0);
+    for (vid v = 0; v < n; ++v) {
+        ++start[degree[v] + 1];
+    }
+    for (score d = 1; d <= maxDegree + 1; ++d) {
+        start[d] += start[d - 1];
+    }
+    this->order.resize(n);
+    for (vid v = 0; v < n; ++v) {
+        position[v] = start[degree[v]]++;
+        this->order[position[v]] = v;
+    }
+    for (score d = maxDegree + 1; d > 0; --d) {
+        start[d] = start[d - 1];
+    }
+    start[0] = 0;
+
+    for (cardinal i = 0; i < n; ++i) {
+        vid v {this->order[i]};
+        for (auto &u : this->graph.getNeighbors(v)) {
+            if (degree[u] <= degree[v]) continue; // already removed, or removed at the same time
+            cardinal first {start[degree[u]]};
+            vid w {this->order[first]};
+            if (u != w) {
+                swap(this->order[position[u]], this->order[first]);
+                position[w] = position[u];
+                position[u] = first;
+            }
+            ++start[degree[u]];
+            --degree[u];
+        }
+    }
+}
+
+// The order itself is the queue of the breadth-first search
+void Ordering::orderByBFS(bool reverseCuthillMcKee)
+{
+    cardinal n {this->graph.getSize()};
+    vector<vid> starts(n);
+    vector<bool> visited(n, false);
+    auto byDegree = [this](vid v, vid w) {
+        score a {this->graph[v].getDegree()}, b {this->graph[w].getDegree()};
+        return (a != b) ? a < b : v < w;
+    };
+    for (vid v = 0; v < n; ++v) {
+        starts[v] = v;
+    }
+    if (reverseCuthillMcKee) sort(starts.begin(), starts.end(), byDegree);
+
+    this->order.clear();
+    this->order.reserve(n);
+    for (auto &s : starts) {
+        if (visited[s]) continue;
+        visited[s] = true;
+        this->order.push_back(s);
+        for (cardinal head = this->order.size() - 1; head < this->order.size(); ++head) {
+            cardinal first {this->order.size()};
+            for (auto &w : this->graph.getNeighbors(this->order[head])) {
+                if (!visited[w]) {
+                    visited[w] = true;
+                    this->order.push_back(w);
+                }
+            }
+            if (reverseCuthillMcKee) sort(this->order.begin() + first, this->order.end(), byDegree);
+        }
+    }
+    if (reverseCuthillMcKee) reverse(this->order.begin(), this->order.end());
+}
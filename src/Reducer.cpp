@@ -0,0 +1,405 @@
+// Project: Maximum Independent Set (MIS, version 5)
+// Computer Science (2016-2017), 4th semester
+// Author: Guillaume Cocatre-Zilgien
+// Professor: Michel Ventou
+
+#include <limits>
+#include "Reducer.hpp"
+
+using namespace std;
+
+const unsigned UNREACHABLE = numeric_limits<unsigned>::max();
+
+Reducer::Reducer(Graph &g, bool s) : graph(g), structural {s}, stamp {0}, counters {0, 0, 0, 0, 0, 0, 0}
+{
+    cardinal n {g.vertices.size()};
+    this->queued.assign(n, false);
+    this->marks.assign(n, 0);
+    this->counts.assign(n, 0);
+    this->worklist.reserve(n);
+}
+
+void Reducer::enqueue(vid v)
+{
+    if (!this->queued[v]) {
+        this->queued[v] = true;
+        this->worklist.push_back(v);
+    }
+}
+
+void Reducer::enqueueAll()
+{
+    for (auto &vertex : this->graph.vertices) {
+        if (vertex.enabled) this->enqueue(vertex.id);
+    }
+}
+
+void Reducer::newStamp()
+{
+    if (++this->stamp == 0) { // the stamp wrapped around: old marks must be erased
+        this->marks.assign(this->marks.size(), 0);
+        this->stamp = 1;
+    }
+}
+
+void Reducer::markNeighbors(vid v)
+{
+    this->newStamp();
+    for (auto &w : this->getNeighbors(v)) {
+        this->marks[w] = this->stamp;
+    }
+}
+
+void Reducer::excludeVertex(vid v)
+{
+    for (auto &w : this->getNeighbors(v)) {
+        this->enqueue(w);
+    }
+    this->graph.disableVertex(v);
+}
+
+void Reducer::includeVertex(vid v)
+{
+    for (auto &w : this->getNeighbors(v)) {
+        for (auto &x : this->getNeighbors(w)) {
+            if (x != v) this->enqueue(x);
+        }
+    }
+    this->graph.disableVertexNeighborhood(v);
+}
+
+/**
+ *  A vertex with a degree of 2, whose neighbors are connected to each other, is always part of a MIS.
+ */
+bool Reducer::reduceTriangle(vid v)
+{
+    Vertex &vertex {this->getVertex(v)};
+    if (vertex.degree != 2) return false;
+    auto it = this->getNeighbors(v).begin();
+    vid a {*it++}, b {*it};
+    if (!this->graph.areVerticesConnected(a, b)) return false;
+    this->includeVertex(v);
+    ++this->counters.triangle;
+    return true;
+}
+
+/**
+ *  Two disconnected vertices with the same 2 or 3 neighbors (twins) are both part of a MIS, as long as no more than
+ *  2 of those neighbors can be part of it: with 2 neighbors that is always true (if they are connected, the triangle
+ *  reduction applies first), with 3 neighbors, it is true if 2 of them are connected.
+ */
+bool Reducer::reduceTwin(vid v)
+{
+    Vertex &vertex {this->getVertex(v)};
+    score d {vertex.degree};
+    if (d != 2 && d != 3) return false;
+
+    this->markNeighbors(v);
+    vid twin {NO_VERTEX_FOUND};
+    for (auto &t : this->getNeighbors(*this->getNeighbors(v).begin())) {
+        Vertex &candidate {this->getVertex(t)};
+        if (t == v || candidate.degree != d || this->marks[t] == this->stamp) continue;
+        score shared {0};
+        for (auto &w : this->getNeighbors(t)) {
+            if (this->marks[w] == this->stamp) ++shared;
+        }
+        if (shared == d) {
+            twin = t;
+            break;
+        }
+    }
+    if (twin == NO_VERTEX_FOUND) return false;
+
+    if (d == 3) {
+        auto it = this->getNeighbors(v).begin();
+        vid a {*it++}, b {*it++}, c {*it};
+        if (!this->graph.areVerticesConnected(a, b) && !this->graph.areVerticesConnected(a, c)
+            && !this->graph.areVerticesConnected(b, c)) {
+            return false;
+        }
+    }
+    this->includeVertex(v); // the twin becomes isolated, and is therefore part of the MIS as well
+    ++this->counters.twin;
+    return true;
+}
+
+/**
+ *  A neighbor u of v that is connected to all the other neighbors of v dominates v: if u is part of a MIS,
+ *  it can be replaced by v, so u can be disabled. That includes the neighbor of a vertex with a degree of 1.
+ */
+bool Reducer::reduceDominated(vid v)
+{
+    Vertex &vertex {this->getVertex(v)};
+    if (vertex.degree == 1) {
+        this->includeVertex(v);
+        ++this->counters.pendant;
+        return true;
+    }
+
+    this->markNeighbors(v);
+    vid dominating {NO_VERTEX_FOUND};
+    for (auto &u : this->getNeighbors(v)) {
+        Vertex &neighbor {this->getVertex(u)};
+        if (neighbor.degree < vertex.degree) continue;
+        score shared {0};
+        for (auto &w : this->getNeighbors(u)) {
+            if (this->marks[w] == this->stamp) ++shared;
+        }
+        if (shared == vertex.degree - 1) {
+            dominating = u;
+            break;
+        }
+    }
+    if (dominating == NO_VERTEX_FOUND) return false;
+    this->excludeVertex(dominating);
+    ++this->counters.dominated;
+    return true;
+}
+
+/**
+ *  Xiao & Nagamochi: starting with S = {v}, look for a neighbor u of S with a single neighbor in S.
+ *  If all the neighbors of u are in S or next to S, v is unconfined: there is a MIS without v. If u has a single
+ *  neighbor w outside of S and its neighborhood, w is added to S, and we try again. Otherwise v is confined.
+ */
+bool Reducer::reduceUnconfined(vid v)
+{
+    vector<vid> &S {this->confining}, &touched {this->touched};
+    bool unconfined {false};
+    S.assign(1, v);
+    touched.clear();
+
+    this->newStamp(); // marks[x] == stamp means that x is in S
+    this->marks[v] = this->stamp;
+    for (auto &x : this->getNeighbors(v)) {
+        if (this->counts[x]++ == 0) touched.push_back(x);
+    }
+
+    while (true) {
+        vid next {NO_VERTEX_FOUND};
+        cardinal minOutside {numeric_limits<cardinal>::max()};
+        for (cardinal i = 0; i < S.size() && minOutside > 0; ++i) {
+            for (auto &u : this->getNeighbors(S[i])) {
+                if (this->counts[u] != 1) continue;
+                cardinal outside {0};
+                vid w {NO_VERTEX_FOUND};
+                for (auto &x : this->getNeighbors(u)) {
+                    if (this->marks[x] != this->stamp && this->counts[x] == 0) {
+                        w = x;
+                        if (++outside > 1) break;
+                    }
+                }
+                if (outside < minOutside) {
+                    minOutside = outside;
+                    next = w;
+                    if (outside == 0) break;
+                }
+            }
+        }
+
+        if (minOutside == 0) {
+            unconfined = true;
+            break;
+        } else if (minOutside == 1 && S.size() < MAX_CONFINING_SET) {
+            S.push_back(next);
+            this->marks[next] = this->stamp;
+            for (auto &x : this->getNeighbors(next)) {
+                if (this->counts[x]++ == 0) touched.push_back(x);
+            }
+        } else {
+            break;
+        }
+    }
+
+    for (auto &x : touched) {
+        this->counts[x] = 0;
+    }
+    if (unconfined) {
+        this->excludeVertex(v);
+        ++this->counters.unconfined;
+    }
+    return unconfined;
+}
+
+/**
+ *  A vertex v with a degree of 2, whose neighbors u and w are not connected: either v is part of a MIS, or both
+ *  u and w are. The three vertices are folded into u, which gets the neighbors of w; the fold is recorded so that
+ *  the MIS can be lifted (if u is part of the MIS, so is w, otherwise v is).
+ */
+bool Reducer::reduceFold(vid v)
+{
+    Vertex &vertex {this->getVertex(v)};
+    if (vertex.degree != 2) return false;
+    auto it = this->getNeighbors(v).begin();
+    vid u {*it++}, w {*it};
+    if (this->getVertex(u).degree < this->getVertex(w).degree) {
+        swap(u, w); // fewer edges to add
+    }
+
+    this->markNeighbors(u);
+    vector<vid> added;
+    for (auto &x : this->getNeighbors(w)) {
+        if (x != v && this->marks[x] != this->stamp) added.push_back(x);
+    }
+    for (auto &x : added) {
+        this->graph.connectVertices(u, x);
+    }
+    this->excludeVertex(v);
+    this->excludeVertex(w);
+    for (auto &x : this->getNeighbors(u)) {
+        this->enqueue(x);
+    }
+    this->graph.folds.push_back({v, u, w});
+    ++this->counters.folded;
+    return true;
+}
+
+/**
+ *  Nemhauser & Trotter: the LP relaxation of the vertex cover problem has a half-integral optimal solution, computed
+ *  from a maximum matching of the bipartite double cover of the graph (every vertex has a left and a right copy).
+ *  There is a MIS that contains every vertex at 0 and none of the vertices at 1 (crowns are a special case).
+ */
+bool Reducer::reduceLP()
+{
+    cardinal n {this->graph.vertices.size()};
+    vector<cardinal> offsets(n + 1, 0);
+    vector<vid> adjacency;
+    for (auto &vertex : this->graph.vertices) {
+        for (auto &w : this->getNeighbors(vertex.id)) adjacency.push_back(w);
+        offsets[vertex.id + 1] = adjacency.size();
+    }
+
+    // Hopcroft & Karp, starting from a greedy matching
+    vector<vid> matchL(n, NO_VERTEX_FOUND), matchR(n, NO_VERTEX_FOUND), stack;
+    vector<unsigned> dist(n);
+    vector<cardinal> next(n);
+    for (vid v = 0; v < n; ++v) {
+        for (cardinal i = offsets[v]; i < offsets[v + 1]; ++i) {
+            if (matchR[adjacency[i]] == NO_VERTEX_FOUND) {
+                matchL[v] = adjacency[i];
+                matchR[adjacency[i]] = v;
+                break;
+            }
+        }
+    }
+
+    while (true) {
+        vector<vid> queue;
+        bool found {false};
+        for (vid v = 0; v < n; ++v) {
+            if (matchL[v] == NO_VERTEX_FOUND && offsets[v + 1] > offsets[v]) {
+                dist[v] = 0;
+                queue.push_back(v);
+            } else {
+                dist[v] = UNREACHABLE;
+            }
+        }
+        for (cardinal q = 0; q < queue.size(); ++q) {
+            vid v {queue[q]};
+            for (cardinal i = offsets[v]; i < offsets[v + 1]; ++i) {
+                vid x {matchR[adjacency[i]]};
+                if (x == NO_VERTEX_FOUND) {
+                    found = true;
+                } else if (dist[x] == UNREACHABLE) {
+                    dist[x] = dist[v] + 1;
+                    queue.push_back(x);
+                }
+            }
+        }
+        if (!found) break;
+
+        // Depth-first search for vertex-disjoint augmenting paths along the layers (without recursion)
+        for (vid v = 0; v < n; ++v) next[v] = offsets[v];
+        for (vid root = 0; root < n; ++root) {
+            if (matchL[root] != NO_VERTEX_FOUND || dist[root] != 0) continue;
+            stack.assign(1, root);
+            while (!stack.empty()) {
+                vid v {stack.back()};
+                if (next[v] == offsets[v + 1]) {
+                    dist[v] = UNREACHABLE; // dead end
+                    stack.pop_back();
+                    continue;
+                }
+                vid u {adjacency[next[v]++]}, x {matchR[u]};
+                if (x == NO_VERTEX_FOUND) {
+                    for (auto level = stack.rbegin(); level != stack.rend(); ++level) {
+                        vid previous {matchL[*level]};
+                        matchL[*level] = u;
+                        matchR[u] = *level;
+                        u = previous;
+                    }
+                    stack.clear();
+                } else if (dist[x] == dist[v] + 1) {
+                    stack.push_back(x);
+                }
+            }
+        }
+    }
+
+    // König: vertices reachable from free left vertices along alternating paths
+    vector<bool> reachedL(n, false), reachedR(n, false);
+    vector<vid> queue;
+    for (vid v = 0; v < n; ++v) {
+        if (matchL[v] == NO_VERTEX_FOUND && offsets[v + 1] > offsets[v]) {
+            reachedL[v] = true;
+            queue.push_back(v);
+        }
+    }
+    for (cardinal q = 0; q < queue.size(); ++q) {
+        vid v {queue[q]};
+        for (cardinal i = offsets[v]; i < offsets[v + 1]; ++i) {
+            vid u {adjacency[i]};
+            if (!reachedR[u]) {
+                reachedR[u] = true;
+                if (matchR[u] != NO_VERTEX_FOUND && !reachedL[matchR[u]]) {
+                    reachedL[matchR[u]] = true;
+                    queue.push_back(matchR[u]);
+                }
+            }
+        }
+    }
+
+    // The vertices at 0 are independent, and all of their neighbors are at 1
+    bool changed {false};
+    for (vid v = 0; v < n; ++v) {
+        if (reachedL[v] && !reachedR[v] && offsets[v + 1] > offsets[v] && this->getVertex(v).degree > 0) {
+            this->includeVertex(v);
+            ++this->counters.LP;
+            changed = true;
+        }
+    }
+    for (vid v = 0; v < n; ++v) {
+        if (!reachedL[v] && reachedR[v] && this->getVertex(v).enabled) {
+            this->excludeVertex(v);
+            ++this->counters.LP;
+            changed = true;
+        }
+    }
+    return changed;
+}
+
+/**
+ *  Vertices with a degree of 1 are handled with the dominated vertices. The cheapest reductions are tried first.
+ *  Inside the exact algorithm, only the cheapest ones are used (domination only for vertices with a small degree):
+ *  they are applied at every node of the search tree, where the others cost more than they save.
+ */
+void Reducer::reduce()
+{
+    do {
+        while (!this->worklist.empty()) {
+            vid v {this->worklist.back()};
+            this->worklist.pop_back();
+            this->queued[v] = false;
+
+            Vertex &vertex {this->getVertex(v)};
+            if (!vertex.enabled || vertex.degree == 0) continue;
+
+            if (this->reduceTriangle(v) || this->reduceTwin(v)) continue;
+            if (this->structural) {
+                if (this->reduceDominated(v) || this->reduceUnconfined(v)) continue;
+                this->reduceFold(v);
+            } else if (vertex.degree <= MAX_SEARCH_DEGREE) {
+                this->reduceDominated(v);
+            }
+        }
+    } while (this->structural && this->reduceLP());
+}
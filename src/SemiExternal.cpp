@@ -0,0 +1,314 @@
+// Project: Maximum Independent Set (MIS, version 5)
+// Computer Science (2016-2017), 4th semester
+// Author: Guillaume Cocatre-Zilgien
+// Professor: Michel Ventou
+
+#include <fstream>
+#include <iostream>
+#include <sys/resource.h>
+#include "SemiExternal.hpp"
+
+using namespace std;
+
+EdgeStream::EdgeStream(const char *path) : buffer(STREAM_BUFFER_SIZE), position {0}, size {0}, bytesRead {0},
+                                           numberOfVertices {0}, valid {true}
+{
+    this->file = fopen(path, "rb");
+    if (this->file == nullptr) return;
+
+    // Same rules as Graph(const char *): comments, then "p edge N M", "p col N M" or "N"
+    char letter;
+    unsigned long numbers[2];
+    unsigned count;
+    while (this->numberOfVertices == 0 && this->readLine(letter, numbers, count)) {
+        if (letter == 'M') break;
+        if ((letter == 'p' || letter == 0) && count >= 1) this->numberOfVertices = numbers[0];
+    }
+}
+
+EdgeStream::~EdgeStream()
+{
+    if (this->file != nullptr) fclose(this->file);
+}
+
+// Comments are skipped, as well as every number after the first two of a line
+bool EdgeStream::readLine(char &letter, unsigned long *numbers, unsigned &count)
+{
+    if (this->file == nullptr) return false;
+    int c {this->getChar()};
+    if (c == EOF) return false;
+    while (c == ' ' || c == '\t') c = this->getChar();
+    letter = ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z')) ? (char) c : 0;
+    count = 0;
+    while (c != '\n' && c != EOF) {
+        if (c >= '0' && c <= '9' && letter != 'c') {
+            unsigned long number {0};
+            while (c >= '0' && c <= '9') {
+                number = number * 10 + (unsigned long) (c - '0');
+                c = this->getChar();
+            }
+            if (count < 2) numbers[count] = number;
+            ++count;
+        } else {
+            c = this->getChar();
+        }
+    }
+    return true;
+}
+
+bool EdgeStream::next(vid &v, vid &w)
+{
+    char letter;
+    unsigned long numbers[2];
+    unsigned count;
+    while (this->valid && this->readLine(letter, numbers, count)) {
+        if (letter == 'M') break;
+        if ((letter == 'e' || letter == 0) && count >= 2) {
+            if (numbers[0] == 0 || numbers[1] == 0 || numbers[0] > this->numberOfVertices ||
+                numbers[1] > this->numberOfVertices) {
+                this->valid = false;
+                break;
+            }
+            v = (vid) (numbers[0] - 1);
+            w = (vid) (numbers[1] - 1);
+            return true;
+        }
+    }
+    return false;
+}
+
+SemiExternal::SemiExternal(const char *path) : path {path}, n {0}, size {0}, greedySize {0}, rounds {0}, passes {0},
+                                               bytesRead {0}, valid {true}
+{
+    EdgeStream edges(path);
+    this->n = edges.getNumberOfVertices();
+    this->degrees.assign(this->n, 0);
+    vid v, w;
+    while (edges.next(v, w)) {
+        if (v == w) continue;
+        ++this->degrees[v];
+        ++this->degrees[w];
+    }
+    ++this->passes;
+    this->bytesRead += edges.getBytesRead();
+    this->valid = edges.isOpen() && edges.isValid() && this->n > 0;
+}
+
+// Counting sort of the vertices by degree
+void SemiExternal::rankVertices()
+{
+    score maxDegree {0};
+    for (auto &degree : this->degrees) {
+        maxDegree = max(maxDegree, degree);
+    }
+    vector<cardinal> start(maxDegree + 2, 0);
+    for (auto &degree : this->degrees) {
+        ++start[degree + 1];
+    }
+    for (score d = 1; d <= maxDegree; ++d) {
+        start[d] += start[d - 1];
+    }
+    this->ranks.resize(this->n);
+    for (vid v = 0; v < this->n; ++v) {
+        this->ranks[v] = (vid) start[this->degrees[v]]++;
+    }
+}
+
+// Every vertex starts in the set; an edge whose vertices are both still in it takes out the one of larger degree
+void SemiExternal::findGreedySet()
+{
+    this->states.assign(this->n, STATE_IN);
+    this->streamEdges([this](vid v, vid w) {
+        if (this->states[v] == STATE_IN && this->states[w] == STATE_IN) {
+            this->states[this->getLastRank(v, w)] = STATE_OUT;
+        }
+    });
+}
+
+/**
+ *  Two passes per round: the vertices with no neighbor in the set become candidates, then the candidate of larger
+ *  degree of every edge between two candidates is dropped. The candidate of smallest degree is never dropped, so every
+ *  round but the last one adds at least one vertex.
+ */
+cardinal SemiExternal::completeSet()
+{
+    cardinal added {0}, candidates {1};
+    while (candidates > 0) {
+        this->counts.assign(this->n, 0);
+        this->streamEdges([this](vid v, vid w) {
+            if (this->states[v] == STATE_IN) this->counts[w] = 1;
+            if (this->states[w] == STATE_IN) this->counts[v] = 1;
+        });
+        candidates = 0;
+        for (vid v = 0; v < this->n; ++v) {
+            if (this->states[v] == STATE_OUT && this->counts[v] == 0) {
+                this->states[v] = STATE_CANDIDATE;
+                ++candidates;
+            }
+        }
+        if (candidates == 0) break;
+
+        this->streamEdges([this](vid v, vid w) {
+            if (this->states[v] == STATE_CANDIDATE && this->states[w] == STATE_CANDIDATE) {
+                this->states[this->getLastRank(v, w)] = STATE_OUT;
+            }
+        });
+        for (vid v = 0; v < this->n; ++v) {
+            if (this->states[v] == STATE_CANDIDATE) {
+                this->states[v] = STATE_IN;
+                ++added;
+            }
+        }
+    }
+    this->size += added;
+    return added;
+}
+
+/**
+ *  Three passes:
+ *  1. The vertices out of the set that have exactly one neighbor in it (their owner) become candidates.
+ *  2. Of two candidates of the same owner that are connected, the one of larger degree is dropped; an owner that is
+ *     left with at least two candidates leaves the set, and its candidates take its place.
+ *  3. Of two owners whose candidates are connected, the one of larger degree stays in the set, and its candidates do
+ *     not enter it.
+ *  Candidates are only connected to their owner in the set, so the set stays independent, and grows by at least one
+ *  vertex for every owner that left it.
+ */
+cardinal SemiExternal::swapVertices()
+{
+    this->counts.assign(this->n, 0);
+    this->owners.assign(this->n, NO_VERTEX_FOUND);
+    auto addOwner = [this](vid v, vid u) {
+        if (this->counts[v] == 0) {
+            this->owners[v] = u;
+            this->counts[v] = 1;
+        } else if (this->owners[v] != u) {
+            this->counts[v] = 2;
+        }
+    };
+    this->streamEdges([this, &addOwner](vid v, vid w) {
+        if (this->states[v] == STATE_IN && this->states[w] != STATE_IN) addOwner(w, v);
+        if (this->states[w] == STATE_IN && this->states[v] != STATE_IN) addOwner(v, w);
+    });
+    for (vid v = 0; v < this->n; ++v) {
+        if (this->states[v] == STATE_OUT && this->counts[v] == 1) this->states[v] = STATE_CANDIDATE;
+    }
+
+    this->streamEdges([this](vid v, vid w) {
+        if (this->states[v] == STATE_CANDIDATE && this->states[w] == STATE_CANDIDATE &&
+            this->owners[v] == this->owners[w]) {
+            this->states[this->getLastRank(v, w)] = STATE_OUT;
+        }
+    });
+    for (vid v = 0; v < this->n; ++v) {
+        if (this->states[v] == STATE_CANDIDATE && this->counts[this->owners[v]] < 2) ++this->counts[this->owners[v]];
+    }
+    for (vid u = 0; u < this->n; ++u) {
+        if (this->states[u] == STATE_IN && this->counts[u] >= 2) this->states[u] = STATE_LEAVING;
+    }
+    for (vid v = 0; v < this->n; ++v) {
+        if (this->states[v] == STATE_CANDIDATE && this->states[this->owners[v]] != STATE_LEAVING) {
+            this->states[v] = STATE_OUT;
+        }
+    }
+
+    this->streamEdges([this](vid v, vid w) {
+        if (this->states[v] == STATE_CANDIDATE && this->states[w] == STATE_CANDIDATE) {
+            vid a {this->owners[v]}, b {this->owners[w]};
+            if (this->states[a] == STATE_LEAVING && this->states[b] == STATE_LEAVING) {
+                this->states[this->getLastRank(a, b)] = STATE_REVERTED;
+            }
+        }
+    });
+    cardinal added {0}, removed {0};
+    for (vid v = 0; v < this->n; ++v) {
+        if (this->states[v] == STATE_CANDIDATE) {
+            if (this->states[this->owners[v]] == STATE_REVERTED) {
+                this->states[v] = STATE_OUT;
+            } else {
+                this->states[v] = STATE_IN;
+                ++added;
+            }
+        }
+    }
+    for (vid u = 0; u < this->n; ++u) {
+        if (this->states[u] == STATE_LEAVING) {
+            this->states[u] = STATE_OUT;
+            ++removed;
+        } else if (this->states[u] == STATE_REVERTED) {
+            this->states[u] = STATE_IN;
+        }
+    }
+    this->size = this->size + added - removed;
+    return added - removed;
+}
+
+cardinal SemiExternal::findMIS(unsigned maxRounds)
+{
+    if (!this->valid) return 0;
+    this->rankVertices();
+    this->findGreedySet();
+    this->size = 0;
+    for (auto &state : this->states) {
+        if (state == STATE_IN) ++this->size;
+    }
+    this->completeSet();
+    this->greedySize = this->size;
+    for (this->rounds = 0; this->rounds < maxRounds && this->valid; ++this->rounds) {
+        if (this->swapVertices() == 0) break;
+        this->completeSet();
+    }
+    return this->size;
+}
+
+bool SemiExternal::checkMIS()
+{
+    bool independent {true};
+    this->streamEdges([this, &independent](vid v, vid w) {
+        if (this->states[v] == STATE_IN && this->states[w] == STATE_IN) independent = false;
+    });
+    return independent && this->valid;
+}
+
+bool SemiExternal::saveMIS(const char *path)
+{
+    ofstream file;
+    file.open(path, ios::out);
+    if (!file.is_open()) {
+        cerr << "Error while opening file " << path << endl;
+        return false;
+    }
+
+    file << this->n << "\n";
+    this->streamEdges([&file](vid v, vid w) {
+        file << v + 1 << " " << w + 1 << "\n";
+    });
+    for (vid v = 0; v < this->n; ++v) {
+        if (this->degrees[v] == 0) {
+            file << v + 1 << "\n";
+        }
+    }
+
+    file << "\nMIS: " << this->size << "\n";
+    for (vid v = 0; v < this->n; ++v) {
+        if (this->states[v] == STATE_IN) {
+            file << v + 1 << " ";
+        }
+    }
+    file << endl;
+
+    file.close();
+    return true;
+}
+
+// ru_maxrss is in kilobytes on Linux, and in bytes on OS X
+double SemiExternal::getPeakMemory()
+{
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+    return usage.ru_maxrss / (1024.0 * 1024.0);
+#else
+    return usage.ru_maxrss / 1024.0;
+#endif
+}
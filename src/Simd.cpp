@@ -0,0 +1,119 @@
+// Project: Maximum Independent Set (MIS, version 5)
+// Computer Science (2016-2017), 4th semester
+// Author: Guillaume Cocatre-Zilgien
+// Professor: Michel Ventou
+
+#include "Simd.hpp"
+
+#if !defined(NO_SIMD) && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SIMD_AVX2
+#include <immintrin.h>
+#endif
+
+using namespace std;
+
+namespace
+{
+    typedef size_t (*findFunction)(const unsigned *, size_t, unsigned);
+    typedef unsigned (*sumFunction)(const unsigned *, size_t, const unsigned *);
+
+    size_t findVertexScalar(const unsigned *list, size_t size, unsigned v)
+    {
+        for (size_t i = 0; i < size; ++i) {
+            if (list[i] == v) return i;
+        }
+        return size;
+    }
+
+    unsigned sumScoresScalar(const unsigned *list, size_t size, const unsigned *scores)
+    {
+        unsigned sum {0};
+        for (size_t i = 0; i < size; ++i) {
+            sum += scores[list[i]];
+        }
+        return sum;
+    }
+
+#ifdef SIMD_AVX2
+    // 16 vertices are compared at a time; the position of the first match is given by the comparison masks
+    __attribute__((target("avx2")))
+    size_t findVertexAVX2(const unsigned *list, size_t size, unsigned v)
+    {
+        __m256i key {_mm256_set1_epi32((int) v)};
+        size_t i {0};
+        for (; i + 16 <= size; i += 16) {
+            __m256i a {_mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i *) (list + i)), key)};
+            __m256i b {_mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i *) (list + i + 8)), key)};
+            if (!_mm256_testz_si256(_mm256_or_si256(a, b), _mm256_or_si256(a, b))) {
+                unsigned mask {(unsigned) _mm256_movemask_ps(_mm256_castsi256_ps(a))
+                    | ((unsigned) _mm256_movemask_ps(_mm256_castsi256_ps(b)) << 8)};
+                return i + (size_t) __builtin_ctz(mask);
+            }
+        }
+        return i + findVertexScalar(list + i, size - i, v);
+    }
+
+    // The vertices are the indices of the gather: 8 scores are added at a time
+    __attribute__((target("avx2")))
+    unsigned sumScoresAVX2(const unsigned *list, size_t size, const unsigned *scores)
+    {
+        __m256i sum {_mm256_setzero_si256()};
+        size_t i {0};
+        for (; i + 8 <= size; i += 8) {
+            __m256i index {_mm256_loadu_si256((const __m256i *) (list + i))};
+            sum = _mm256_add_epi32(sum, _mm256_i32gather_epi32((const int *) scores, index, sizeof(unsigned)));
+        }
+        __m128i half {_mm_add_epi32(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1))};
+        half = _mm_add_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(1, 0, 3, 2)));
+        half = _mm_add_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(2, 3, 0, 1)));
+        return (unsigned) _mm_cvtsi128_si32(half) + sumScoresScalar(list + i, size - i, scores);
+    }
+#endif
+
+    bool hasAVX2()
+    {
+#ifdef SIMD_AVX2
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2");
+#else
+        return false;
+#endif
+    }
+
+    // The kernels are chosen once, the first time they are needed
+    struct Kernels
+    {
+        bool vectorized;
+        findFunction find;
+        sumFunction sum;
+        Kernels() : vectorized {hasAVX2()}, find {findVertexScalar}, sum {sumScoresScalar} {
+#ifdef SIMD_AVX2
+            if (this->vectorized) {
+                this->find = findVertexAVX2;
+                this->sum = sumScoresAVX2;
+            }
+#endif
+        }
+    };
+
+    const Kernels & getKernels()
+    {
+        static const Kernels kernels;
+        return kernels;
+    }
+}
+
+size_t simd::findVertexKernel(const unsigned *list, size_t size, unsigned v)
+{
+    return getKernels().find(list, size, v);
+}
+
+unsigned simd::sumScoresKernel(const unsigned *list, size_t size, const unsigned *scores)
+{
+    return getKernels().sum(list, size, scores);
+}
+
+bool simd::isVectorized()
+{
+    return getKernels().vectorized;
+}
@@ -0,0 +1,79 @@
+// Project: Maximum Independent Set (MIS, version 5)
+// Computer Science (2016-2017), 4th semester
+// Author: Guillaume Cocatre-Zilgien
+// Professor: Michel Ventou
+
+#include <cstring>
+#include "TranspositionTable.hpp"
+
+using namespace std;
+
+// The number of sets is rounded down to a power of 2, so that a key is turned into a set with a mask. Nothing is
+// allocated yet: most searches never reach a subgraph small enough to be stored, and clearing the table would cost them
+// more than the search itself.
+TranspositionTable::TranspositionTable(size_t bytes) : numberOfSets {bytes / (TABLE_WAYS * sizeof(Entry))}, mask {0},
+                                                       numberOfEvictions {0}
+{
+    while ((this->numberOfSets & (this->numberOfSets - 1)) != 0) {
+        this->numberOfSets &= this->numberOfSets - 1;
+    }
+    if (this->numberOfSets > 0) this->mask = this->numberOfSets - 1;
+}
+
+bool TranspositionTable::lookup(hashKey key, hashKey check, tableResult &result)
+{
+    lock_guard<mutex> guard(this->lock);
+    if (this->entries.empty()) return false;
+    Entry *set {&this->entries[(key & this->mask) * TABLE_WAYS]};
+    for (unsigned i = 0; i < TABLE_WAYS; ++i) {
+        if ((set[i].flags & USED) && set[i].key == key && set[i].check == (uint32_t) check) {
+            set[i].flags |= REFERENCED;
+            result.bound = set[i].bound;
+            result.exact = (set[i].flags & EXACT) != 0;
+            memcpy(result.selected, set[i].selected, sizeof(result.selected));
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ *  If the subgraph is already in the table, a MIS replaces what was there (a bound, or a MIS that did not match the
+ *  subgraph, see Graph::findSmallMIS()), and of two bounds the smallest is kept (both are valid). Otherwise, the clock hand of the set goes over its entries, clearing their flags, until it finds an entry
+ *  that was not read recently (or an empty one). That takes at most TABLE_WAYS + 1 steps.
+ */
+void TranspositionTable::store(hashKey key, hashKey check, const tableResult &result)
+{
+    if (this->numberOfSets == 0 || result.bound > MAX_TABLE_THRESHOLD) return;
+    lock_guard<mutex> guard(this->lock);
+    if (this->entries.empty()) {
+        this->entries.resize(this->numberOfSets * TABLE_WAYS);
+        memset(this->entries.data(), 0, this->entries.size() * sizeof(Entry));
+        this->hands.assign(this->numberOfSets, 0);
+    }
+    hashKey index {key & this->mask};
+    Entry *set {&this->entries[index * TABLE_WAYS]};
+    Entry *entry {nullptr};
+    for (unsigned i = 0; i < TABLE_WAYS && entry == nullptr; ++i) {
+        if ((set[i].flags & USED) && set[i].key == key && set[i].check == (uint32_t) check) {
+            if (!result.exact && ((set[i].flags & EXACT) || set[i].bound <= result.bound)) return;
+            entry = &set[i];
+        }
+    }
+
+    if (entry == nullptr) {
+        uint8_t &hand {this->hands[index]};
+        while ((set[hand].flags & USED) && (set[hand].flags & REFERENCED)) {
+            set[hand].flags &= (uint8_t) ~REFERENCED;
+            hand = (uint8_t) ((hand + 1) % TABLE_WAYS);
+        }
+        if (set[hand].flags & USED) ++this->numberOfEvictions;
+        entry = &set[hand];
+        hand = (uint8_t) ((hand + 1) % TABLE_WAYS);
+    }
+    entry->key = key;
+    entry->check = (uint32_t) check;
+    entry->bound = (uint16_t) result.bound;
+    entry->flags = (uint8_t) (USED | (result.exact ? EXACT : 0));
+    memcpy(entry->selected, result.selected, sizeof(entry->selected));
+}
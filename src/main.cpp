@@ -4,24 +4,38 @@
 // Professor: Michel Ventou
 
 #include <cstdio>
+#include <cstring>
+#include <getopt.h>
 #include <unistd.h>
+#include <fstream>
 #include <iostream>
 #include "Timer.hpp"
 #include "Graph.hpp"
+#include "GraphLoader.hpp"
+#include "DynamicMIS.hpp"
+#include "Generator.hpp"
+#include "Ordering.hpp"
+#include "Reducer.hpp"
+#include "SemiExternal.hpp"
+#include "TranspositionTable.hpp"
 #include "GUI.hpp"
 
 using namespace std;
 
 #define SHOW_N_VERTICES 60
+#define ORDERING_RUNS 3
 
-void computeMIS(Graph &original, Graph &g, vidSet &MIS, algorithm algo)
+void computeMIS(Graph &original, Graph &g, vidSet &MIS, algorithm algo, double deadline = 0.0)
 {
     Timer t;
+    g.setDeadline(deadline);
     switch (algo) {
         case ALGO_MDG:  printf("MDG:   ");  MIS = g.findMIS(ALGO_MDG);   break;
         case ALGO_VSA:  printf("VSA:   ");  MIS = g.findMIS(ALGO_VSA);   break;
         case ALGO_MVSA: printf("MVSA:  ");  MIS = g.findMIS(ALGO_MVSA);  break;
         case ALGO_BEST: printf("BEST:  ");  MIS = g.findMIS(ALGO_BEST);  break;
+        case ALGO_PORTFOLIO: printf("PORTFOLIO: "); MIS = g.findMIS(ALGO_PORTFOLIO); break;
+        case ALGO_EXACT_BITSET: printf("BITSET: "); MIS = g.findMIS(ALGO_EXACT_BITSET); break;
 
         case ALGO_EXACT:
         default:        printf("EXACT: "); MIS = g.findMIS(ALGO_EXACT); break;
@@ -30,31 +44,183 @@ void computeMIS(Graph &original, Graph &g, vidSet &MIS, algorithm algo)
     printf("[ %3lu ]", MIS.size());
 
     if (secs < 1.0) {
-        printf(" \t%5.1f ms\n", secs * 1000.0);
+        printf(" \t%5.1f ms", secs * 1000.0);
     } else {
-        printf(" \t%5.1f s\n", secs);
+        printf(" \t%5.1f s", secs);
     }
 
-    if (!original.checkMIS(MIS)) {
+    if (deadline > 0.0 && (algo == ALGO_EXACT || algo == ALGO_EXACT_BITSET)) {
+        if (g.isOptimal()) {
+            printf("\t(proven optimal)");
+        } else {
+            cardinal bound {g.getUpperBound()};
+            printf("\t(deadline reached: upper bound %lu, gap %.1f%%)",
+                bound, (bound - MIS.size()) * 100.0 / (MIS.size() > 0 ? MIS.size() : 1));
+        }
+    }
+
+    misCheck check {original.checkMIS(MIS)};
+    if (check == MIS_NOT_MAXIMAL) {
+        printf("\t(not maximal)");
+    }
+    printf("\n");
+
+    if (check == MIS_INVALID) {
+        fprintf(stderr, "Error: invalid MIS!\n");
+    }
+
+    // The counters belong to the engine that just ran (the next one starts them over)
+    if (algo == ALGO_EXACT || algo == ALGO_EXACT_BITSET) {
+        printf("        Number of recursive calls: %llu\n", g.getNumberOfCalls());
+    }
+    if (algo == ALGO_EXACT) {
+        printf("        Branches cut by the clique cover: %llu\n", g.getNumberOfCuts());
+        printf("        Transposition table: %llu hits, %llu misses\n", g.getNumberOfTableHits(),
+            g.getNumberOfTableMisses());
+    }
+}
+
+// The heuristic that depends the most on the order of the vertices (it reads the supports of the neighbors)
+double timeOrdering(Graph &g)
+{
+    double best {g.timeHeuristic(ALGO_MVSA)};
+    for (int i = 1; i < ORDERING_RUNS; ++i) {
+        best = min(best, g.timeHeuristic(ALGO_MVSA));
+    }
+    return best;
+}
+
+/**
+ *  Each ordering is applied to a copy of the graph, and MVSA is timed on it (the fastest of a few runs), against the
+ *  graph in the order of the file; with "all", the graph keeps the ordering that made MVSA the fastest.
+ */
+void relabelGraph(Graph &g, const vector<ordering> &orderings)
+{
+    Timer t;
+    double before {timeOrdering(g)}, fastest {before};
+    Graph best;
+    bool relabeled {false};
+    printf("Ordering none: MVSA in %.1f ms\n", before);
+    for (auto o : orderings) {
+        Graph h(g);
+        t.reset();
+        h.relabel(o);
+        double relabeling {t.countMilliseconds()}, after {timeOrdering(h)};
+        printf("Ordering %s: relabeled in %.1f ms, MVSA in %.1f ms (speedup %.2fx)\n",
+            Ordering::getName(o), relabeling, after, (after > 0.0) ? before / after : 1.0);
+        if (orderings.size() == 1 || after < fastest) {
+            fastest = after;
+            best = h;
+            relabeled = true;
+        }
+    }
+    if (relabeled) g = best;
+}
+
+// The graph is never loaded: its edges are read from the file at each pass (see SemiExternal)
+int runSemiExternal(const char *inputFile, const char *outputFile, unsigned rounds)
+{
+    Timer t;
+    SemiExternal g(inputFile);
+    if (!g.isValid()) {
+        fprintf(stderr, "Error: unable to read the graph in %s\n", inputFile);
+        return 1;
+    }
+    printf("Semi-external: %lu vertices\n\n", g.getNumberOfVertices());
+    cardinal size {g.findMIS(rounds)};
+    double secs {t.countSeconds()};
+    printf("GREEDY: [ %3lu ]\n", g.getGreedySize());
+    printf("SWAPS: [ %3lu ] \t%5.1f s\t(one-k-swaps: %u rounds)\n", size, secs, g.getNumberOfRounds());
+    if (!g.checkMIS()) {
+        fprintf(stderr, "Error: invalid MIS!\n");
+    }
+    if (outputFile != nullptr) {
+        g.saveMIS(outputFile);
+    }
+    printf("\nPasses over the file: %u, %.1f MB read, peak memory %.1f MB\n",
+        g.getNumberOfPasses(), g.getBytesRead() / (1024.0 * 1024.0), SemiExternal::getPeakMemory());
+    return 0;
+}
+
+int runDynamic(Graph &g, const char *updateFile, unsigned interval)
+{
+    ifstream file;
+    bool standardInput {strcmp(updateFile, "-") == 0};
+    if (!standardInput) {
+        file.open(updateFile, ios::in);
+        if (!file.is_open()) {
+            fprintf(stderr, "Error: unable to open file %s\n", updateFile);
+            return 1;
+        }
+    }
+    DynamicMIS dynamic(g, interval);
+    dynamic.run(standardInput ? cin : file);
+    vidSet set {dynamic.getSet()};
+    misCheck check {g.checkMIS(set)};
+    printf("Final set: %lu vertices%s\n", set.size(),
+        (check == MIS_MAXIMAL) ? "" : (check == MIS_NOT_MAXIMAL) ? "\t(not maximal)" : "");
+    if (check == MIS_INVALID) {
         fprintf(stderr, "Error: invalid MIS!\n");
+        return 1;
     }
+    return 0;
 }
 
 void printHelp()
 {
-    printf("Usage: ./MIS -n VERTEX_COUNT  [ -p EDGE_PERCENTAGE ] [ -e ] [ -o result.txt ]\n"
-           "   or: ./MIS -i graph.txt [ -e ] [ -o result.txt ]\n\n"
+    printf("Usage: ./MIS -n VERTEX_COUNT  [ -p EDGE_PERCENTAGE ] [ -e | -b ] [ --deadline SECONDS ] [ -o result.txt ]\n"
+           "   or: ./MIS -i graph.txt [ -e | -b ] [ --deadline SECONDS ] [ -o result.txt ] [ -s graph.misg ]\n"
+           "   or: ./MIS -i graph.txt --semi-external [ -o result.txt ]\n"
+           "   or: ./MIS -i graph.txt --dynamic updates.txt [ --resolve-interval NUMBER ]\n"
+           "   or: ./MIS -n VERTEX_COUNT --model MODEL [ --degree NUMBER ] [ --seed NUMBER ]\n\n"
            "    -h          Display help\n"
            "    -e          Run the exact algorithm\n"
+           "    -b          Run the exact algorithm on bitsets\n"
+           "    -t NUMBER   Run the exact algorithm on bitsets, with N threads\n"
+           "    -j NUMBER   Restart randomized heuristics on N threads (portfolio)\n"
+           "    --portfolio-time SECONDS\n"
+           "                Duration of the portfolio (1 second by default)\n"
+           "    --deadline SECONDS\n"
+           "                Stop the exact algorithms after N seconds, with the best MIS found so far\n"
+           "    --table MEGABYTES\n"
+           "                Size of the transposition table of the exact algorithm (%lu by default, 0: none)\n"
+           "    --table-threshold NUMBER\n"
+           "                Largest subgraph stored in the transposition table (%lu vertices by default, at most %lu)\n"
+           "    --matrix-threshold NUMBER\n"
+           "                Largest graph whose adjacency tests use a matrix (%lu vertices by default, larger: hash set)\n"
+           "    --local-search NUMBER\n"
+           "                Iterations of the local search that improves the heuristics (%llu by default, 0: none)\n"
+           "    --local-search-time SECONDS\n"
+           "                Stop the local search after N seconds (with --local-search 0: run it for N seconds)\n"
+           "    --semi-external\n"
+           "                Keep only the vertices in memory, and read the edges from the file (-i) at each pass\n"
+           "    --swap-rounds NUMBER\n"
+           "                Rounds of one-k-swaps of the semi-external mode (%u by default)\n"
+           "    --dynamic FILE\n"
+           "                Keep a MIS as the graph follows updates (a file, or -: stdin): +e U V, -e U V, +v, -v U\n"
+           "    --resolve-interval NUMBER\n"
+           "                Updates between two re-solves of the dynamic mode (%u by default, 0: only when needed)\n"
+           "    --order ORDERING\n"
+           "                Renumber the vertices: degeneracy, rcm, bfs, or all (keeps the fastest), and time it\n"
            "    -i FILE     Load a file containing a graph\n"
            "    -o FILE     Save the graph in a file\n"
+           "    -s FILE     Save the graph and its MIS in a binary snapshot (.misg), that -i loads without parsing\n"
            "    -n NUMBER   Generate a random graph with N vertices\n"
            "    -p NUMBER   Set the percentage of edges when generating a graph\n"
+           "    --model MODEL\n"
+           "                Model of the generated graph: gnm (by default), gnp, geometric, chung-lu or rmat\n"
+           "    --degree NUMBER\n"
+           "                Average degree of the generated graph (%.0f by default with --model, or given by -p)\n"
+           "    --seed NUMBER\n"
+           "                Seed of the random numbers (generation, local search, portfolio): the same run again\n"
            "    -x PIXELS   Window width in pixels (800 by default)\n"
            "    -y PIXELS   Window height in pixels (600 by default)\n"
            "\nA few notes: only graphs with %d vertices or less, will be displayed graphically.\n"
            "Heuristics are always executed.\n"
-           "In order to generate a graph with a random number of vertices, specify -n 0.\n", SHOW_N_VERTICES);
+           "In order to generate a graph with a random number of vertices, specify -n 0.\n",
+           (unsigned long) (DEFAULT_TABLE_SIZE >> 20), (unsigned long) DEFAULT_TABLE_THRESHOLD,
+           (unsigned long) MAX_TABLE_THRESHOLD, (unsigned long) DEFAULT_MATRIX_THRESHOLD, DEFAULT_SEARCH_ITERATIONS, DEFAULT_SWAP_ROUNDS,
+           DEFAULT_RESOLVE_INTERVAL, DEFAULT_AVERAGE_DEGREE, SHOW_N_VERTICES);
 }
 
 int main(int argc, char * argv[]) {
@@ -65,16 +231,48 @@ int main(int argc, char * argv[]) {
 
     Graph g;
     cardinal n {0};
-    float percentage {50.0};
-    char *inputFile {nullptr}, *outputFile {nullptr};
+    float percentage {0.0};
+    char *inputFile {nullptr}, *outputFile {nullptr}, *snapshotFile {nullptr}, *updateFile {nullptr};
+    vidSet storedMIS;                           // MIS read from a snapshot
     Timer t;
-    bool forceExact {false};
+    bool forceExact {false}, forceBitset {false}, generate {false}, semiExternal {false};
     vector<vidSet> sets(ALGO_ENUM_SIZE);
-    int x {0}, y {0};
+    int x {0}, y {0}, threads {1}, portfolioThreads {0};
+    double deadline {0.0};
+    long matrixThreshold {-1};
+    long tableSize {-1}, tableThreshold {-1};
+    long long searchIterations {(long long) DEFAULT_SEARCH_ITERATIONS};
+    long swapRounds {DEFAULT_SWAP_ROUNDS}, resolveInterval {DEFAULT_RESOLVE_INTERVAL};
+    double searchSeconds {0.0}, portfolioSeconds {DEFAULT_PORTFOLIO_TIME};
+    graphModel model {MODEL_GNM};
+    double degree {0.0};
+    unsigned seed {0};
+    bool seeded {false};
+    vector<ordering> orderings;
 
     // parameter handling
+    const struct option longOptions[] = {
+        {"help",     no_argument,       nullptr, 'h'},
+        {"deadline", required_argument, nullptr, 'd'},
+        {"table",    required_argument, nullptr, 'T'},
+        {"table-threshold", required_argument, nullptr, 'H'},
+        {"matrix-threshold", required_argument, nullptr, 'M'},
+        {"local-search", required_argument, nullptr, 'L'},
+        {"local-search-time", required_argument, nullptr, 'S'},
+        {"portfolio-time", required_argument, nullptr, 'P'},
+        {"order",    required_argument, nullptr, 'O'},
+        {"semi-external", no_argument,  nullptr, 'E'},
+        {"swap-rounds", required_argument, nullptr, 'W'},
+        {"snapshot", required_argument, nullptr, 's'},
+        {"dynamic",  required_argument, nullptr, 'U'},
+        {"resolve-interval", required_argument, nullptr, 'R'},
+        {"model",    required_argument, nullptr, 'G'},
+        {"degree",   required_argument, nullptr, 'A'},
+        {"seed",     required_argument, nullptr, 'Z'},
+        {nullptr,    0,                 nullptr, 0}
+    };
     int c; opterr = 0;
-    while ((c = getopt(argc, argv, "hei:o:n:p:x:y:")) != -1) {
+    while ((c = getopt_long(argc, argv, "hebt:j:i:o:s:n:p:x:y:", longOptions, nullptr)) != -1) {
         switch (c) {
             case 'h':
                 printHelp();
@@ -85,36 +283,169 @@ int main(int argc, char * argv[]) {
                 forceExact = true;
                 break;
 
+            case 'b':
+                forceBitset = true;
+                break;
+
+            case 't':
+                threads = atoi(optarg);
+                if (threads < 1 || threads > 256) {
+                    fprintf(stderr, "Error: the number of threads must be anywhere from 1 to 256.\n");
+                    exit(1);
+                }
+                forceBitset = true;
+                break;
+
+            case 'j':
+                portfolioThreads = atoi(optarg);
+                if (portfolioThreads < 1 || portfolioThreads > 256) {
+                    fprintf(stderr, "Error: the number of threads must be anywhere from 1 to 256.\n");
+                    exit(1);
+                }
+                break;
+
+            case 'P':
+                portfolioSeconds = atof(optarg);
+                if (portfolioSeconds <= 0.0) {
+                    fprintf(stderr, "Error: the duration of the portfolio must be a positive number of seconds.\n");
+                    exit(1);
+                }
+                break;
+
+            case 'd':
+                deadline = atof(optarg);
+                if (deadline <= 0.0) {
+                    fprintf(stderr, "Error: the deadline must be a positive number of seconds.\n");
+                    exit(1);
+                }
+                break;
+
+            case 'T':
+                tableSize = atol(optarg);
+                if (tableSize < 0 || tableSize > 65536) {
+                    fprintf(stderr, "Error: the size of the transposition table must be anywhere from 0 to 65536 MB.\n");
+                    exit(1);
+                }
+                break;
+
+            case 'H':
+                tableThreshold = atol(optarg);
+                if (tableThreshold < 1 || tableThreshold > (long) MAX_TABLE_THRESHOLD) {
+                    fprintf(stderr, "Error: the threshold of the transposition table must be anywhere from 1 to %lu.\n",
+                        (unsigned long) MAX_TABLE_THRESHOLD);
+                    exit(1);
+                }
+                break;
+
+            case 'M':
+                matrixThreshold = atol(optarg);
+                if (matrixThreshold < 0) {
+                    fprintf(stderr, "Error: the threshold of the adjacency matrix cannot be negative.\n");
+                    exit(1);
+                }
+                break;
+
+            case 'L':
+                searchIterations = atoll(optarg);
+                if (searchIterations < 0) {
+                    fprintf(stderr, "Error: the number of iterations of the local search cannot be negative.\n");
+                    exit(1);
+                }
+                break;
+
+            case 'S':
+                searchSeconds = atof(optarg);
+                if (searchSeconds <= 0.0) {
+                    fprintf(stderr, "Error: the duration of the local search must be a positive number of seconds.\n");
+                    exit(1);
+                }
+                break;
+
+            case 'E':
+                semiExternal = true;
+                break;
+
+            case 'W':
+                swapRounds = atol(optarg);
+                if (swapRounds < 0) {
+                    fprintf(stderr, "Error: the number of rounds of one-k-swaps cannot be negative.\n");
+                    exit(1);
+                }
+                break;
+
+            case 'U':
+                updateFile = optarg;
+                break;
+
+            case 'R':
+                resolveInterval = atol(optarg);
+                if (resolveInterval < 0) {
+                    fprintf(stderr, "Error: the number of updates between two re-solves cannot be negative.\n");
+                    exit(1);
+                }
+                break;
+
+            case 'G':
+                model = MODEL_ENUM_SIZE;
+                for (int m = MODEL_GNM; m < MODEL_ENUM_SIZE; ++m) {
+                    if (strcmp(optarg, Generator::getName((graphModel) m)) == 0) model = (graphModel) m;
+                }
+                if (model == MODEL_ENUM_SIZE) {
+                    fprintf(stderr, "Error: the model must be gnm, gnp, geometric, chung-lu or rmat.\n");
+                    exit(1);
+                }
+                generate = true;
+                break;
+
+            case 'A':
+                degree = atof(optarg);
+                if (degree <= 0.0) {
+                    fprintf(stderr, "Error: the average degree must be positive.\n");
+                    exit(1);
+                }
+                break;
+
+            case 'Z':
+                seed = (unsigned) strtoul(optarg, nullptr, 10);
+                seeded = true;
+                break;
+
+            case 'O':
+                orderings.clear();
+                for (int o = ORDER_NONE + 1; o < ORDER_ENUM_SIZE; ++o) {
+                    if (strcmp(optarg, "all") == 0 || strcmp(optarg, Ordering::getName((ordering) o)) == 0) {
+                        orderings.push_back((ordering) o);
+                    }
+                }
+                if (orderings.empty()) {
+                    fprintf(stderr, "Error: the ordering must be degeneracy, rcm, bfs or all.\n");
+                    exit(1);
+                }
+                break;
+
             case 'i':
                 inputFile = optarg;
-                g = Graph(inputFile);
                 break;
 
             case 'o':
                 outputFile = optarg;
                 break;
 
+            case 's':
+                snapshotFile = optarg;
+                break;
+
             case 'n':
-                n = (unsigned) atoi(optarg);
-                if (n > 5000) {
-                    fprintf(stderr, "Error: the number of vertices must be 5000 or less.\n");
+                n = (cardinal) strtoul(optarg, nullptr, 10);
+                if (n >= NO_VERTEX_FOUND) {
+                    fprintf(stderr, "Error: the number of vertices must be less than %u.\n", NO_VERTEX_FOUND);
                     exit(1);
-                } else if (n > 1) {
-                    g = Graph(n);
-                } else {
-                    g = Graph(RANDOM_NUMBER_OF_VERTICES);
                 }
+                generate = true;
                 break;
 
             case 'p':
-                printf("Generating a random graph… ");
                 percentage = atof(optarg);
-                t.reset();
-                if (percentage > 0.999 && percentage < 100.001)
-                    g.connectRandomly(percentage);
-                else
-                    g.connectRandomly(0.0);
-                printf("in %.1f seconds\n", t.countSeconds());
                 break;
 
             case 'x':
@@ -134,7 +465,11 @@ int main(int argc, char * argv[]) {
                 break;
 
             case '?':
-                fprintf(stderr, "Invalid parameter: -%c\n", optopt);
+                if (optopt != 0) {
+                    fprintf(stderr, "Invalid parameter: -%c\n", optopt);
+                } else {
+                    fprintf(stderr, "Invalid parameter: %s\n", argv[optind - 1]);
+                }
                 exit(1);
                 break;
         }
@@ -145,45 +480,122 @@ int main(int argc, char * argv[]) {
         exit(1);
     }
 
+    // The graph is loaded (or generated) once every parameter is known
+    if (semiExternal) {
+        if (inputFile == nullptr) {
+            fprintf(stderr, "Error: the semi-external mode reads the graph from a file (-i).\n");
+            exit(1);
+        }
+        return runSemiExternal(inputFile, outputFile, (unsigned) swapRounds);
+    } else if (inputFile != nullptr) {
+        GraphLoader loader(inputFile);
+        if (loader.isSnapshot()) {
+            printf("Reading %s… %.1f MB in %.1f ms (snapshot)\n", inputFile, loader.getBytes() / 1e6,
+                loader.getSeconds() * 1000.0);
+            storedMIS = loader.getStoredMIS();
+        } else if (loader.isValid()) {
+            printf("Reading %s… %.1f MB in %.1f ms (%.1f MB/s, %u thread%s)\n", inputFile, loader.getBytes() / 1e6,
+                loader.getSeconds() * 1000.0, loader.getRate(), loader.getNumberOfThreads(),
+                (loader.getNumberOfThreads() > 1) ? "s" : "");
+        }
+        g = Graph(loader);
+        if (seeded) g.setSeed(seed);
+    } else if (generate) {
+        if (!seeded) seed = random_device()(); // printed, so that the same graph can be generated again
+        g = Graph((n > 1) ? n : 2 + seed % 39); // a random number of vertices (2 to 40)
+        g.setSeed(seed);
+        printf("Generating a random graph (%s, seed %u)… ", Generator::getName(model), seed);
+        t.reset();
+        if (model == MODEL_GNM && degree <= 0.0) {
+            g.connectRandomly((percentage > 0.999 && percentage < 100.001) ? percentage : 0.0);
+        } else {
+            if (degree <= 0.0) {
+                degree = (percentage > 0.0) ? percentage / 100.0 * (g.getSize() - 1) : DEFAULT_AVERAGE_DEGREE;
+            }
+            g.connectRandomly(model, degree);
+        }
+        printf("in %.1f seconds\n", t.countSeconds());
+    }
+
     if (g.getSize() == 0) {
         fprintf(stderr, "A problem occured while generating the graph…\n");
         exit(1);
     }
 
-    if (g.getNumberOfEdges() == 0) {
+    if (g.getNumberOfEdges() == 0 && !generate) {
         printf("Generating a random graph… ");
         t.reset();
         g.connectRandomly(0.0);
         printf("in %.1f seconds\n", t.countSeconds());
     }
     n = g.getSize();
+    if (matrixThreshold >= 0) {
+        g.setMatrixThreshold((cardinal) matrixThreshold);
+    }
+    g.setTable((tableSize >= 0) ? ((size_t) tableSize << 20) : DEFAULT_TABLE_SIZE,
+        (tableThreshold > 0) ? (cardinal) tableThreshold : DEFAULT_TABLE_THRESHOLD);
 
     // We keep a copy of the original, unprocessed graph, in order to test the validity of the resulting MIS
     // (and potentially spot bugs in the code)
     Graph copy(g);
 
-    printf("%lu vertices, %u edges (%.1f%% of max = %u, %.1f per vertex on average)\n\n",
+    printf("%lu vertices, %u edges (%.1f%% of max = %llu, %.1f per vertex on average)\n",
         n, g.getNumberOfEdges(), g.getEdgePercentage(), g.getMaxNumberOfEdges(), g.getNumberOfEdgesPerVertex());
+    if (!storedMIS.empty()) {
+        misCheck check {copy.checkMIS(storedMIS)};
+        printf("MIS stored in the snapshot: %lu vertices%s\n", storedMIS.size(),
+            (check == MIS_MAXIMAL) ? "" : (check == MIS_NOT_MAXIMAL) ? " (not maximal)" : " (INVALID)");
+    }
+
+    // Follow a stream of updates instead (the reductions and the renumbering would change the graph)
+    if (updateFile != nullptr) {
+        g.setLocalSearch((unsigned long long) searchIterations, searchSeconds);
+        return runDynamic(g, updateFile, (unsigned) resolveInterval);
+    }
+
+    // Renumber the vertices, if the user asked for it (the sets that are printed and saved keep the IDs of the file)
+    if (!orderings.empty()) {
+        relabelGraph(g, orderings);
+    }
+
+    // Apply the reductions once, before any algorithm (the results are lifted back to the original graph)
+    t.reset();
+    Reducer reducer(g, true);
+    reducer.enqueueAll();
+    reducer.reduce();
+    printf("Reductions: %lu vertices and %u edges left in %.1f ms\n\n",
+        g.getKernelSize(), g.getNumberOfEdges(), t.countMilliseconds());
 
     // Always execute heuristics (they cost next to nothing in processing time)
+    g.setLocalSearch((unsigned long long) searchIterations, searchSeconds);
     for (auto a : {ALGO_BEST, ALGO_MDG, ALGO_VSA, ALGO_MVSA}) {
         computeMIS(copy, g, sets[a], a);
     }
+    if (portfolioThreads > 0) {
+        g.setPortfolio((unsigned) portfolioThreads, portfolioSeconds);
+        computeMIS(copy, g, sets[ALGO_PORTFOLIO], ALGO_PORTFOLIO);
+    }
 
     // Execute the exact algorithm if the user asked for it, or if the graph is small
     if (n <= SHOW_N_VERTICES || forceExact) {
-        computeMIS(copy, g, sets[ALGO_EXACT], ALGO_EXACT);
+        computeMIS(copy, g, sets[ALGO_EXACT], ALGO_EXACT, deadline);
+    }
+    if (forceBitset) {
+        g.setNumberOfThreads((unsigned) threads);
+        computeMIS(copy, g, sets[ALGO_EXACT_BITSET], ALGO_EXACT_BITSET, deadline);
     }
 
     printf("\nCardinalities of Maximum Independent Sets that were found:\n");
-    for (auto a : {ALGO_MDG, ALGO_VSA, ALGO_MVSA, ALGO_EXACT}) {
+    for (auto a : {ALGO_MDG, ALGO_VSA, ALGO_MVSA, ALGO_PORTFOLIO, ALGO_EXACT, ALGO_EXACT_BITSET}) {
         if (sets[a].size() > 0) {
             switch (a) {
                 case ALGO_VSA:   printf("VSA:   "); break;
                 case ALGO_MDG:   printf("MDG:   "); break;
                 case ALGO_MVSA:  printf("MVSA:  "); break;
                 case ALGO_BEST:  printf("BEST:  "); break;
+                case ALGO_PORTFOLIO: printf("PORTFOLIO: "); break;
                 case ALGO_EXACT: printf("EXACT: "); break;
+                case ALGO_EXACT_BITSET: printf("BITSET: "); break;
                 default: break;
             }
             for (vid v : sets[a]) {
@@ -195,15 +607,23 @@ int main(int argc, char * argv[]) {
         }
     }
 
-    printf("\nNumber of recursive calls: %llu\n", g.getNumberOfCalls());
+    if (portfolioThreads > 0) {
+        printf("\nPortfolio: %llu heuristics on %d threads\n", g.getNumberOfRestarts(), portfolioThreads);
+    }
 
     // Sort the list of sets in order to find the largest one
-    sort(sets.begin(), sets.end(), [](vidSet a, vidSet b) { return a.size() > b.size(); });
+    sort(sets.begin(), sets.end(), [](const vidSet &a, const vidSet &b) { return a.size() > b.size(); });
     auto MISpt = sets.begin(); // pointer to the largest MIS
 
     // Save the graph in a file that was specified by the user
     if (outputFile != nullptr && MISpt->size() > 0) {
-        g.saveMIS(*MISpt, outputFile);
+        copy.saveMIS(*MISpt, outputFile);
+    }
+    if (snapshotFile != nullptr) {
+        t.reset();
+        if (copy.saveSnapshot(*MISpt, snapshotFile)) {
+            printf("Snapshot saved in %s in %.1f ms\n", snapshotFile, t.countMilliseconds());
+        }
     }
 
     // If the graph is small enough, let's display it graphically
@@ -215,7 +635,7 @@ int main(int argc, char * argv[]) {
         } else if (x == 0) {
             x = (y * 4 / 3);
         }
-        GraphWindow w(x, y, &g, &(*MISpt)); // MISpt is NOT a pointer to vidSet
+        GraphWindow w(x, y, &copy, &(*MISpt)); // MISpt is NOT a pointer to vidSet
         w.run();
     }
 
@@ -0,0 +1,72 @@
+// Project: Maximum Independent Set (MIS, version 5)
+// Computer Science (2016-2017), 4th semester
+// Author: Guillaume Cocatre-Zilgien
+// Professor: Michel Ventou
+
+// Regression test of the exact algorithm: on random graphs, the exact search (ALGO_EXACT) must find a MIS as large as
+// the one of the bitset version (ALGO_EXACT_BITSET), and prove it optimal. The exact search starts from a weak
+// incumbent (a single vertex, without any local search), so that its subgraphs often have more isolated vertices than
+// the MIS found so far: the target given to SmallMIS used to wrap around, and the larger set was thrown away.
+// A second series of larger, sparse graphs falls apart into many small components, which come back in several
+// branches: their MIS is then taken from the transposition table instead of being searched again.
+
+#include <cstdio>
+#include "Graph.hpp"
+
+using namespace std;
+
+#define NUMBER_OF_GRAPHS 200
+#define MIN_VERTICES 40
+#define MAX_VERTICES 80
+#define NUMBER_OF_SPARSE_GRAPHS 40
+#define SPARSE_VERTICES 800
+#define SPARSE_DEGREE 3.0
+
+// Lets the test choose the MIS that the exact search starts from
+class WeakGraph : public Graph
+{
+public:
+    WeakGraph(const Graph &g) : Graph(g) {}
+    void setIncumbent(vid v)                    { this->MIS.clear(); this->MIS.insert(v); }
+};
+
+// Runs the exact search from a single vertex, and compares its result with the bitset version
+bool checkGraph(Graph &g, unsigned i, unsigned long long &hits)
+{
+    Graph reference(g);
+    cardinal expected {reference.findMIS(ALGO_EXACT_BITSET).size()};
+
+    WeakGraph weak(g);
+    weak.setLocalSearch(0, 0.0);
+    weak.setIncumbent(0);
+    vidSet set {weak.findMIS(ALGO_EXACT)};
+    hits += weak.getNumberOfTableHits();
+    if (set.size() != expected || !weak.isOptimal() || g.checkMIS(set) == MIS_INVALID) {
+        printf("FAILED: graph %u (%lu vertices, %u edges): EXACT %lu%s, BITSET %lu\n", i, g.getSize(),
+            g.getNumberOfEdges(), set.size(), weak.isOptimal() ? " (proven optimal)" : "", expected);
+        return false;
+    }
+    return true;
+}
+
+int main()
+{
+    const float percentages[] {5.0, 10.0, 20.0, 30.0, 50.0};
+    unsigned failures {0};
+    unsigned long long hits {0};
+    for (unsigned i = 0; i < NUMBER_OF_GRAPHS; ++i) {
+        Graph g(MIN_VERTICES + (i * 7) % (MAX_VERTICES - MIN_VERTICES + 1));
+        g.setSeed(i + 1);
+        g.connectRandomly(percentages[i % 5]);
+        if (!checkGraph(g, i, hits)) ++failures;
+    }
+    for (unsigned i = 0; i < NUMBER_OF_SPARSE_GRAPHS; ++i) {
+        Graph g(SPARSE_VERTICES);
+        g.setSeed(i + 1);
+        g.connectRandomly(MODEL_GNM, SPARSE_DEGREE);
+        if (!checkGraph(g, NUMBER_OF_GRAPHS + i, hits)) ++failures;
+    }
+    printf("%u graphs, %u failure(s), %llu subgraph(s) taken from the transposition table\n",
+        NUMBER_OF_GRAPHS + NUMBER_OF_SPARSE_GRAPHS, failures, hits);
+    return (failures > 0) ? 1 : 0;
+}